@@ -703,7 +703,17 @@ namespace gr {
        * class. lfast::MTFIRFilterCCC::make is the public interface for
        * creating new instances.
        */
-      static sptr make(int decimation, const std::vector<gr_complex> &taps, int nthreads);
+      /*!
+       * \param decimation decimation rate (1 for no decimation)
+       * \param taps filter taps
+       * \param nthreads number of worker threads
+       * \param polyphase when decimating, split the taps into decimation sub-filters
+       *        and run each against its de-interleaved input phase (contiguous dot products)
+       * \param affinity worker thread placement: 0 none, 1 the cores list, 2 any CPU on the block thread's
+       *        socket, 3 one CPU each on the block thread's NUMA node
+       * \param cores CPU numbers for the workers with affinity 1
+       */
+      static sptr make(int decimation, const std::vector<gr_complex> &taps, int nthreads, bool polyphase=false, int affinity=0, const std::vector<int> &cores=std::vector<int>());
 
       virtual void set_taps(const std::vector<gr_complex> &taps) = 0;
       virtual std::vector<gr_complex> taps() const = 0;
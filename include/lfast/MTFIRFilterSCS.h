@@ -0,0 +1,69 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_LFAST_MTFIRFILTERSCS_H
+#define INCLUDED_LFAST_MTFIRFILTERSCS_H
+
+#include <lfast/api.h>
+#include <gnuradio/sync_decimator.h>
+
+namespace gr {
+  namespace lfast {
+
+    /*!
+     * \brief Multithreaded FIR filter on complex int16 (sc16) samples with int16 taps
+     * \ingroup lfast
+     *
+     * Accumulates in int32 and outputs int16 (saturated after shifting the int32 accumulator right by shift).
+     */
+    class LFAST_API MTFIRFilterSCS : virtual public gr::sync_decimator
+    {
+     public:
+      typedef std::shared_ptr<MTFIRFilterSCS> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of lfast::MTFIRFilterSCS.
+       *
+       * To avoid accidental use of raw pointers, lfast::MTFIRFilterSCS's
+       * constructor is in a private implementation
+       * class. lfast::MTFIRFilterSCS::make is the public interface for
+       * creating new instances.
+       */
+      /*!
+       * \param decimation decimation rate
+       * \param taps int16 filter taps
+       * \param nthreads number of worker threads
+       * \param shift right shift applied to the int32 accumulator before saturating to int16 (15 for Q15 taps)
+       * \param affinity worker thread placement: 0 none, 1 the cores list, 2 any CPU on the block thread's
+       *        socket, 3 one CPU each on the block thread's NUMA node
+       * \param cores CPU numbers for the workers with affinity 1
+       */
+      static sptr make(int decimation, const std::vector<short> &taps, int nthreads, int shift, int affinity=0, const std::vector<int> &cores=std::vector<int>());
+
+      virtual void set_taps(const std::vector<short> &taps) = 0;
+      virtual std::vector<short> taps() const = 0;
+
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_MTFIRFILTERSCS_H */
@@ -0,0 +1,87 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifndef INCLUDED_LFAST_MTFILTERCHAINCCF_H
+#define INCLUDED_LFAST_MTFILTERCHAINCCF_H
+
+#include <lfast/api.h>
+#include <gnuradio/sync_decimator.h>
+
+namespace gr {
+  namespace lfast {
+
+    /*!
+     * \brief Multithreaded fused chain of FIR, rotator and AGC stages
+     * \ingroup lfast
+     *
+     * The FIR and rotator stages run together on cache-sized tiles of the
+     * output, tiles spread across the worker threads, so samples between
+     * stages never go through a block buffer.  AGC stages run on the final
+     * output and must be added after the FIR and rotator stages.
+     * Add the stages before the flowgraph starts.
+     */
+    class LFAST_API MTFilterChainCCF : virtual public gr::sync_decimator
+    {
+     public:
+      typedef std::shared_ptr<MTFilterChainCCF> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of lfast::MTFilterChainCCF.
+       *
+       * To avoid accidental use of raw pointers, lfast::MTFilterChainCCF's
+       * constructor is in a private implementation
+       * class. lfast::MTFilterChainCCF::make is the public interface for
+       * creating new instances.
+       */
+      /*!
+       * \param nthreads number of worker threads
+       * \param affinity worker thread placement: 0 none, 1 the cores list, 2 any CPU on the block thread's
+       *        socket, 3 one CPU each on the block thread's NUMA node
+       * \param cores CPU numbers for the workers with affinity 1
+       */
+      static sptr make(int nthreads, int affinity=0, const std::vector<int> &cores=std::vector<int>());
+
+      /*!
+       * \brief Appends a FIR stage (ignored if taps is empty)
+       * \param taps filter taps
+       * \param decimation decimation rate of this stage
+       */
+      virtual void add_fir(const std::vector<float> &taps, int decimation) = 0;
+
+      /*!
+       * \brief Appends a frequency shift (ignored if phase_inc is 0)
+       * \param phase_inc radians per sample at this point in the chain
+       */
+      virtual void add_rotator(double phase_inc) = 0;
+
+      /*!
+       * \brief Appends an AGC stage (same loop as agc_fast)
+       */
+      virtual void add_agc(float rate, float reference, float gain, float max_gain) = 0;
+
+      virtual int num_stages() = 0;
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_MTFILTERCHAINCCF_H */
@@ -0,0 +1,70 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_LFAST_MTRATIONALRESAMPLERCCF_H
+#define INCLUDED_LFAST_MTRATIONALRESAMPLERCCF_H
+
+#include <lfast/api.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace lfast {
+
+    /*!
+     * \brief Multithreaded polyphase rational resampler (interpolation / decimation)
+     * \ingroup lfast
+     *
+     */
+    class LFAST_API MTRationalResamplerCCF : virtual public gr::block
+    {
+     public:
+      typedef std::shared_ptr<MTRationalResamplerCCF> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of lfast::MTRationalResamplerCCF.
+       *
+       * To avoid accidental use of raw pointers, lfast::MTRationalResamplerCCF's
+       * constructor is in a private implementation
+       * class. lfast::MTRationalResamplerCCF::make is the public interface for
+       * creating new instances.
+       */
+      /*!
+       * \param interpolation interpolation rate
+       * \param decimation decimation rate
+       * \param taps prototype filter taps (designed at the interpolated rate)
+       * \param nthreads number of worker threads
+       * \param affinity worker thread placement: 0 none, 1 the cores list, 2 any CPU on the block thread's
+       *        socket, 3 one CPU each on the block thread's NUMA node
+       * \param cores CPU numbers for the workers with affinity 1
+       */
+      static sptr make(int interpolation, int decimation, const std::vector<float> &taps, int nthreads, int affinity=0, const std::vector<int> &cores=std::vector<int>());
+
+      virtual void set_taps(const std::vector<float> &taps) = 0;
+      virtual std::vector<float> taps() const = 0;
+      virtual unsigned interpolation() const = 0;
+      virtual unsigned decimation() const = 0;
+
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_MTRATIONALRESAMPLERCCF_H */
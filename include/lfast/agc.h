@@ -20,8 +20,8 @@
  * Boston, MA 02110-1301, USA.
  */
 
-#ifndef INCLUDED_ANALOG_AGC_H
-#define INCLUDED_ANALOG_AGC_H
+#ifndef INCLUDED_LFAST_AGC_H
+#define INCLUDED_LFAST_AGC_H
 
 #include <lfast/api.h>
 #include <gnuradio/gr_complex.h>
@@ -147,8 +147,264 @@ namespace gr {
 	float _max_gain;	// maximum gain
       };
 
+      /*!
+       * \brief Automatic Gain Control with separate attack and decay rates for complex signals.
+       *
+       * \details
+       * Same loop as gr::analog::kernel::agc2_cc.  The attack rate is used when the
+       * output level error is larger than the current gain (a jump in level), otherwise
+       * the decay rate.
+       */
+      class LFAST_API agc2_cc
+      {
+      public:
+        /*!
+         * Construct a complex value AGC loop implementation object.
+         *
+         * \param attack_rate the update rate of the loop when in attack mode.
+         * \param decay_rate the update rate of the loop when in decay mode.
+         * \param reference reference value to adjust signal power to.
+         * \param gain initial gain value.
+         * \param max_gain maximum gain value (0 for unlimited).
+         */
+	agc2_cc(float attack_rate = 1e-1, float decay_rate = 1e-2,
+		float reference = 1.0,
+		float gain = 1.0, float max_gain = 0.0)
+	  : _attack_rate(attack_rate), _decay_rate(decay_rate),
+	  _reference(reference),
+	  _gain(gain), _max_gain(max_gain) {};
+
+	virtual ~agc2_cc() {};
+
+	float decay_rate() const  { return _decay_rate; }
+	float attack_rate() const { return _attack_rate; }
+	float reference() const   { return _reference; }
+	float gain() const        { return _gain;  }
+	float max_gain() const    { return _max_gain; }
+
+	void set_decay_rate(float rate) { _decay_rate = rate; }
+	void set_attack_rate(float rate) { _attack_rate = rate; }
+	void set_reference(float reference) { _reference = reference; }
+	void set_gain(float gain) { _gain = gain; }
+	void set_max_gain(float max_gain) { _max_gain = max_gain; }
+
+	gr_complex scale(gr_complex input)
+	{
+	  gr_complex output = input * _gain;
+
+	  float tmp = -_reference + sqrt(output.real()*output.real() +
+					  output.imag()*output.imag());
+	  float rate = _decay_rate;
+	  if((tmp) > _gain) {
+	    rate = _attack_rate;
+	  }
+	  _gain -= tmp*rate;
+
+	  // Not sure about this; will blow up if _gain < 0 (happens
+	  // when rates are too high), but is this the solution?
+	  if(_gain < 0.0)
+	    _gain = 10e-5;
+
+	  if(_max_gain > 0.0 && _gain > _max_gain) {
+	    _gain = _max_gain;
+	  }
+	  return output;
+	}
+
+	void scaleN(gr_complex output[], const gr_complex input[], unsigned n)
+	{
+	  for(unsigned i = 0; i < n; i++)
+	    output[i] = scale (input[i]);
+	}
+
+      protected:
+	float _attack_rate;	// attack rate for fast changing signals
+	float _decay_rate;	// decay rate for slow changing signals
+	float _reference;	// reference value
+	float _gain;		// current gain
+	float _max_gain;	// max allowable gain
+      };
+
+      /*!
+       * \brief Automatic Gain Control with separate attack and decay rates for float signals.
+       *
+       * Power is approximated by absolute value
+       */
+      class LFAST_API agc2_ff
+      {
+      public:
+        /*!
+         * Construct a floating point value AGC loop implementation object.
+         *
+         * \param attack_rate the update rate of the loop when in attack mode.
+         * \param decay_rate the update rate of the loop when in decay mode.
+         * \param reference reference value to adjust signal power to.
+         * \param gain initial gain value.
+         * \param max_gain maximum gain value (0 for unlimited).
+         */
+	agc2_ff(float attack_rate = 1e-1, float decay_rate = 1e-2,
+		float reference = 1.0,
+		float gain = 1.0, float max_gain = 0.0)
+	  : _attack_rate(attack_rate), _decay_rate(decay_rate),
+	  _reference(reference),
+	  _gain(gain), _max_gain(max_gain) {};
+
+	virtual ~agc2_ff() {};
+
+	float attack_rate() const { return _attack_rate; }
+	float decay_rate() const  { return _decay_rate; }
+	float reference() const   { return _reference; }
+	float gain() const        { return _gain; }
+	float max_gain() const    { return _max_gain; }
+
+	void set_attack_rate(float rate) { _attack_rate = rate; }
+	void set_decay_rate(float rate) { _decay_rate = rate; }
+	void set_reference(float reference) { _reference = reference; }
+	void set_gain(float gain) { _gain = gain; }
+	void set_max_gain(float max_gain) { _max_gain = max_gain; }
+
+	float scale(float input)
+	{
+	  float output = input * _gain;
+
+	  float tmp = (fabsf(output)) - _reference;
+	  float rate = _decay_rate;
+	  if(fabsf(tmp) > _gain) {
+	    rate = _attack_rate;
+	  }
+	  _gain -= tmp*rate;
+
+	  // Not sure about this
+	  if(_gain < 0.0)
+	    _gain = 10e-5;
+
+	  if(_max_gain > 0.0 && _gain > _max_gain) {
+	    _gain = _max_gain;
+	  }
+	  return output;
+	}
+
+	void scaleN(float output[], const float input[], unsigned n)
+	{
+	  for(unsigned i = 0; i < n; i++)
+	    output[i] = scale (input[i]);
+	}
+
+      protected:
+	float _attack_rate;	// attack_rate for fast changing signals
+	float _decay_rate;	// decay rate for slow changing signals
+	float _reference;	// reference value
+	float _gain;		// current gain
+	float _max_gain;	// maximum gain
+      };
+
+      /*!
+       * \brief Level-tracking Automatic Gain Control for complex (bursty) signals.
+       *
+       * \details
+       * In the style of gr::analog::agc3_cc.  The input level is tracked with a
+       * one-pole filter that uses the attack rate when the level rises and the decay
+       * rate when it falls, and the gain is reference / level.  The level is updated
+       * every iir_update_decim samples and the gain is held in between.
+       *
+       * After construction or reset() the first call starts the level at the mean
+       * magnitude of its samples, so a burst is at the right level from its first sample.
+       */
+      class LFAST_API agc3_cc
+      {
+      public:
+        /*!
+         * Construct a complex value AGC loop implementation object.
+         *
+         * \param attack_rate the update rate of the loop when in attack mode.
+         * \param decay_rate the update rate of the loop when in decay mode.
+         * \param reference reference value to adjust signal power to.
+         * \param gain initial gain value (used until the first level estimate).
+         * \param max_gain maximum gain value (0 for unlimited).
+         * \param iir_update_decim samples between level updates.
+         */
+	agc3_cc(float attack_rate = 1e-1, float decay_rate = 1e-2,
+		float reference = 1.0, float gain = 1.0,
+		float max_gain = 0.0, int iir_update_decim = 1)
+	  : _attack_rate(attack_rate), _decay_rate(decay_rate),
+	  _reference(reference), _gain(gain), _max_gain(max_gain),
+	  _level(0.0), _iir_update_decim(iir_update_decim > 0 ? iir_update_decim : 1),
+	  _reset(true) {};
+
+	virtual ~agc3_cc() {};
+
+	float attack_rate() const { return _attack_rate; }
+	float decay_rate() const  { return _decay_rate; }
+	float reference() const   { return _reference; }
+	float gain() const        { return _gain; }
+	float max_gain() const    { return _max_gain; }
+	int iir_update_decim() const { return _iir_update_decim; }
+
+	void set_attack_rate(float rate) { _attack_rate = rate; }
+	void set_decay_rate(float rate) { _decay_rate = rate; }
+	void set_reference(float reference) { _reference = reference; }
+	void set_gain(float gain) { _gain = gain; }
+	void set_max_gain(float max_gain) { _max_gain = max_gain; }
+
+	// The next call re-acquires the level (e.g. at the start of a burst)
+	void reset() { _reset = true; }
+
+	// Fast acquisition: start the level at the mean input magnitude
+	void acquire(float magnitude_sum, unsigned n)
+	{
+	  if(n > 0 && magnitude_sum > 0.0f) {
+	    _level = magnitude_sum / (float)n;
+	    update_gain();
+	  }
+	  _reset = false;
+	}
+
+	// One level update from an input magnitude
+	void update(float magnitude)
+	{
+	  float rate = (magnitude > _level) ? _attack_rate : _decay_rate;
+	  _level = _level + rate * (magnitude - _level);
+	  update_gain();
+	}
+
+	void scaleN(gr_complex output[], const gr_complex input[], unsigned n)
+	{
+	  if(_reset) {
+	    float sum = 0.0f;
+	    for(unsigned i = 0; i < n; i++)
+	      sum += std::abs(input[i]);
+	    acquire(sum, n);
+	  }
+
+	  for(unsigned i = 0; i < n; i++) {
+	    if(i % _iir_update_decim == 0)
+	      update(std::abs(input[i]));
+	    output[i] = input[i] * _gain;
+	  }
+	}
+
+      protected:
+	void update_gain()
+	{
+	  if(_level > 0.0f)
+	    _gain = _reference / _level;
+
+	  if(_max_gain > 0.0 && _gain > _max_gain)
+	    _gain = _max_gain;
+	}
+
+	float _attack_rate;	// rate when the level rises
+	float _decay_rate;	// rate when the level falls
+	float _reference;	// reference value
+	float _gain;		// current gain
+	float _max_gain;	// maximum gain
+	float _level;		// input level estimate
+	int _iir_update_decim;	// samples per level update
+	bool _reset;		// acquire on the next call
+      };
+
     } /* namespace kernel */
   } /* namespace analog */
 } /* namespace gr */
 
-#endif /* INCLUDED_ANALOG_AGC_H */
+#endif /* INCLUDED_LFAST_AGC_H */
@@ -56,6 +56,18 @@ namespace gr {
       virtual void set_reference(float reference) = 0;
       virtual void set_gain(float gain) = 0;
       virtual void set_max_gain(float max_gain) = 0;
+
+      /*!
+       * \brief Block mode: the gain is held for sub-blocks of block_size samples and updated
+       * once per sub-block from their summed magnitudes (0, the default, updates it every sample).
+       * Sub-blocks where the gain would move by more than block_tolerance (relative) are run
+       * sample by sample instead, so the gain applied to any sample stays within about
+       * block_tolerance of the per-sample loop's.
+       */
+      virtual void set_block_size(int block_size) = 0;
+      virtual int block_size() const = 0;
+      virtual void set_block_tolerance(float tolerance) = 0;
+      virtual float block_tolerance() const = 0;
     };
 
   } // namespace lfast
@@ -52,6 +52,27 @@ namespace gr {
       static sptr make(float loop_bw, int order, bool genPDUs);
 
       virtual float error() const = 0;
+
+      /*!
+       * \brief Sub-rate loop: the loop filter is updated once every decim samples from the
+       * averaged detector error, and each decim-sample block is derotated with a vectorized
+       * NCO ramp at the held frequency.  1 (the default) is the per-sample loop.
+       * Keep decim * loop_bw well below 1 or the delayed update can make the loop unstable.
+       */
+      virtual void set_update_decimation(int decim) = 0;
+      virtual int update_decimation() const = 0;
+
+      /*!
+       * \brief Burst mode for msgin PDUs: each PDU is demodulated from its own loop state,
+       * starting from the phase_est / freq_est metadata values if present (0 otherwise),
+       * instead of carrying the stream's state from one PDU to the next.  PDUs already
+       * queued on msgin are demodulated together on burst_threads threads and published
+       * in arrival order.
+       */
+      virtual void set_burst_mode(bool burst_mode) = 0;
+      virtual bool burst_mode() const = 0;
+      virtual void set_burst_threads(int nthreads) = 0;
+      virtual int burst_threads() const = 0;
     };
 
   } // namespace lfast
@@ -0,0 +1,66 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_LFAST_FREQ_SHIFT_H
+#define INCLUDED_LFAST_FREQ_SHIFT_H
+
+#include <lfast/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace lfast {
+
+    /*!
+     * \brief Frequency shift (rotator): out[n] = in[n] * exp(j*phase), phase advancing by phase_inc per sample.
+     * \ingroup lfast
+     *
+     * mode picks the oscillator:
+     * 0 - recursive phasor multiply, re-seeded from the exact phase every 512 samples
+     * 1 - fast polynomial sin/cos (max error about 3e-4)
+     * 2 - accurate polynomial sin/cos (float resolution, the default)
+     */
+    class LFAST_API freq_shift : virtual public gr::sync_block
+    {
+     public:
+      typedef std::shared_ptr<freq_shift> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of lfast::freq_shift.
+       *
+       * To avoid accidental use of raw pointers, lfast::freq_shift's
+       * constructor is in a private implementation
+       * class. lfast::freq_shift::make is the public interface for
+       * creating new instances.
+       */
+      static sptr make(double phase_inc = 0.0, int mode = 2);
+
+      virtual void set_phase_inc(double phase_inc) = 0;
+      virtual double phase_inc() const = 0;
+
+      virtual void set_mode(int mode) = 0;
+      virtual int mode() const = 0;
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_FREQ_SHIFT_H */
+
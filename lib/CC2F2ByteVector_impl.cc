@@ -23,11 +23,6 @@
 #include <volk/volk.h>
 #include "clSComplex.h"
 
-// concurrency function
-#include <thread>
-
-#define SLEEPTIME 6
-
 namespace gr {
 namespace lfast {
 
@@ -54,31 +49,7 @@ CC2F2ByteVector_impl::CC2F2ByteVector_impl(int scale,int vecLength,int numVecIte
 
 	setBufferLength(imaxItems);
 
-	for (int i=0;i<LF_MAX_THREADS;i++) {
-		threads[i] = NULL;
-		threadBlockSize[i] = 0;
-		startIndex[i] = 0;
-		dataReady[i] = false;
-	}
-
-	stopThreads = false;
-
-	// This gets the # of cores available.  We'll use this to scale.
-	concurentThreadsSupported = std::thread::hardware_concurrency();
-	/*
-		if (concurentThreadsSupported <= 0) {
-			std::cout << "ERROR: unable to determine the number of CPU cores available.   Defaulting to 1." << std::endl;
-			concurentThreadsSupported = 1;
-		}
-		else {
-			std::cout << "CC2F2ByteVector] running with " << concurentThreadsSupported << " threads." << std::endl;
-		}
-	 */
-	concurrentMinus1 = concurentThreadsSupported - 1;
-
-	for (int i=0;i<concurentThreadsSupported;i++) {
-		threads[i] = new boost::thread(boost::bind(&CC2F2ByteVector_impl::processItems, this,i));
-	}
+	// work() is a single volk pass per call, so there are no worker threads to start (or place).
 }
 
 /*
@@ -90,21 +61,6 @@ CC2F2ByteVector_impl::~CC2F2ByteVector_impl()
 }
 
 bool CC2F2ByteVector_impl::stop() {
-	stopThreads = true;
-
-	// clean up completed threads
-	// Wait for all threads to finish
-	for (int i=0;i<concurentThreadsSupported;i++) {
-		while (dataReady[i])
-			usleep(SLEEPTIME);
-	}
-	for (int i=0;i<concurentThreadsSupported;i++) {
-		if (threads[i] != NULL)
-			delete threads[i];
-
-		threads[i] = NULL;
-	}
-
 	if (floatBuff) {
 		delete floatBuff;
 		floatBuff = NULL;
@@ -175,60 +131,6 @@ CC2F2ByteVector_impl::work_test(int noutput_items,
 	return noutput_items;
 }
 
-/*
-    int
-    CC2F2ByteVector_impl::work_test(int noutput_items,
-        gr_vector_const_void_star &input_items,
-        gr_vector_void_star &output_items)
-    {
-        gr::thread::scoped_lock guard(d_mutex);
-
-		inBuffer = (const gr_complex *) input_items[0];
-		outBuffer = (char *) output_items[0];
-		// size_t block_size = output_signature()->sizeof_stream_item (0);
-		// unsigned int numSamples = noutput_items; // block_size * noutput_items;
-
-		if (noutput_items > curBufferSize) {
-			setBufferLength(noutput_items);
-		}
-
-		int blockSize = noutput_items / concurentThreadsSupported;
-		int lastBlock = noutput_items - (concurrentMinus1)*blockSize;
-
-		for (int i=0;i<concurentThreadsSupported;i++) {
-			startIndex[i] = i * blockSize;
-			if (i < (concurrentMinus1))
-				threadBlockSize[i] = blockSize;
-			else
-				threadBlockSize[i] = lastBlock;
-
-			dataReady[i] = true;
-		}
-
-		// Wait for all threads to finish
-		for (int i=0;i<concurentThreadsSupported;i++) {
-			while (dataReady[i])
-				usleep(SLEEPTIME);
-		}
-
-		return noutput_items;
-    }
- */
-void CC2F2ByteVector_impl::processItems(int threadIndex) {
-	while (!stopThreads) {
-		if (dataReady[threadIndex] && (threadBlockSize[threadIndex]>0)) {
-			volk_32fc_deinterleave_real_32f(&floatBuff[startIndex[threadIndex]], &inBuffer[startIndex[threadIndex]], threadBlockSize[threadIndex]);
-
-			// float/real to char and char to stream
-			volk_32f_s32f_convert_8i((int8_t *)&outBuffer[startIndex[threadIndex]], &floatBuff[startIndex[threadIndex]], d_scale, threadBlockSize[threadIndex]);
-			dataReady[threadIndex] = false;
-		}
-		else {
-			usleep(SLEEPTIME);
-		}
-	}
-}
-
 int
 CC2F2ByteVector_impl::work(int noutput_items,
 		gr_vector_const_void_star &input_items,
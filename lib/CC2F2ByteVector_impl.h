@@ -22,9 +22,6 @@
 #define INCLUDED_TESTTIMING_CC2F2BYTEVECTOR_IMPL_H
 
 #include <lfast/CC2F2ByteVector.h>
-#include <boost/thread/thread.hpp>
-
-#define LF_MAX_THREADS 8
 
 namespace gr {
   namespace lfast {
@@ -35,28 +32,12 @@ namespace gr {
 		int d_scale;
 		int d_vlen;
 
-		boost::thread *threads[LF_MAX_THREADS];
-		bool dataReady[LF_MAX_THREADS];
-		long threadBlockSize[LF_MAX_THREADS];
-		long startIndex[LF_MAX_THREADS];
-		const gr_complex *inBuffer;
-		char *outBuffer;
-
-		unsigned concurentThreadsSupported;
-		unsigned concurrentMinus1;
-
-		bool stopThreads;
-
-        boost::mutex d_mutex;
-
 		float min_val = -128;
 		float max_val = 127;
 
 		float *floatBuff = NULL;
 		int curBufferSize=0;
 
-		void processItems(int threadIndex);
-
      public:
       CC2F2ByteVector_impl(int scale,int vecLength,int numVecItems);
       ~CC2F2ByteVector_impl();
@@ -691,21 +691,34 @@ namespace gr {
         // gr::filter::kernel::fir_filter_ccf *d_fir;
     	gr::filter::kernel::fir_filter_ccf *d_fir_original;
         gr::lfast::FIRFilterCCF_MT *d_fir;
-        bool d_updated;
+        // Next tap set, built by set_taps off the streaming thread and swapped into d_fir
+        // by work() between calls so the worker threads never see taps change mid-call.
+        gr::lfast::FIRFilterCCF_MT *d_standby;
+        mutable gr::thread::mutex d_updateLock;
+        bool d_tapsPending;
+        int d_pendingThreads;
+        int d_pendingDecimation;
+        std::vector<float> d_currentTaps;
         int d_ndecimation;
+        bool d_polyphase;
 
      public:
-      MTFIRFilterCCF_impl(int decimation, const std::vector<float> &taps, int nthreads);
+      MTFIRFilterCCF_impl(int decimation, const std::vector<float> &taps, int nthreads, bool polyphase=false, int affinity=0, const std::vector<int> &cores=std::vector<int>());
       virtual ~MTFIRFilterCCF_impl();
 
       virtual bool stop();
 
-      void setThreads(int nthreads) { gr::thread::scoped_lock l(d_setlock); d_fir->setThreads(nthreads); };
+      // Applied by work() at the start of the next call
+      void setThreads(int nthreads) { gr::thread::scoped_lock l(d_updateLock); d_pendingThreads = nthreads; };
 
       void set_taps(const std::vector<float> &taps);
       std::vector<float> taps() const;
 
-      void setDecimation(int newDecimation) {d_ndecimation = newDecimation;};
+      // Applied by work() at the start of the next call, since the polyphase sub-filters are rebuilt
+      void setDecimation(int newDecimation) { gr::thread::scoped_lock l(d_updateLock); d_pendingDecimation = newDecimation; };
+
+      // Swaps in pending taps / thread / decimation changes if set_taps isn't mid-update.  Never blocks.
+      void applyPendingUpdates();
 
       int work_original(int noutput_items,
          gr_vector_const_void_star &input_items,
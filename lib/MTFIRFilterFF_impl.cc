@@ -683,15 +683,15 @@ namespace gr {
 namespace lfast {
 
 MTFIRFilterFF::sptr
-MTFIRFilterFF::make(int decimation, const std::vector<float>& taps, int nthreads)
+MTFIRFilterFF::make(int decimation, const std::vector<float>& taps, int nthreads, bool polyphase, int affinity, const std::vector<int> &cores)
 {
-	return gnuradio::make_block_sptr<MTFIRFilterFF_impl>(decimation, taps, nthreads);
+	return gnuradio::make_block_sptr<MTFIRFilterFF_impl>(decimation, taps, nthreads, polyphase, affinity, cores);
 }
 
 /*
  * The private constructor
  */
-MTFIRFilterFF_impl::MTFIRFilterFF_impl(int decimation, const std::vector<float> &taps, int nthreads)
+MTFIRFilterFF_impl::MTFIRFilterFF_impl(int decimation, const std::vector<float> &taps, int nthreads, bool polyphase, int affinity, const std::vector<int> &cores)
 : gr::sync_decimator("MTFIRFilterFF",
 		gr::io_signature::make(1, 1, sizeof(float)),
 		gr::io_signature::make(1, 1, sizeof(float)), decimation)
@@ -699,8 +699,13 @@ MTFIRFilterFF_impl::MTFIRFilterFF_impl(int decimation, const std::vector<float>
 	// d_fir = new gr::filter::kernel::fir_filter_fff(decimation, taps);
 	d_fir_original = new gr::filter::kernel::fir_filter_fff(taps);
 	d_fir = new gr::lfast::FIRFilterFFF_MT(taps,nthreads);
+	d_fir->setAffinity(affinity,cores);
+	// Single-threaded: it only ever holds taps, filtering is done by d_fir's threads.
+	d_standby = new gr::lfast::FIRFilterFFF_MT(taps,1);
+	d_tapsPending = false;
+	d_pendingThreads = 0;
+	d_currentTaps = taps;
 
-	d_updated = false;
 	set_history(d_fir->ntaps());
 
 	const int alignment_multiple =
@@ -708,6 +713,13 @@ MTFIRFilterFF_impl::MTFIRFilterFF_impl(int decimation, const std::vector<float>
 	set_alignment(std::max(1, alignment_multiple));
 
 	d_ndecimation = decimation;
+	d_polyphase = polyphase;
+
+	if (d_polyphase && (d_ndecimation > 1)) {
+		d_fir->setPolyphaseDecimation(d_ndecimation);
+		d_standby->setPolyphaseDecimation(d_ndecimation);
+	}
+
 	// try to make sure we don't get like 20 samples:
 	/*
         int minMultiple = d_fir->ntaps()*nthreads;
@@ -728,6 +740,7 @@ MTFIRFilterFF_impl::~MTFIRFilterFF_impl()
 {
 	stop();
 	delete d_fir;
+	delete d_standby;
 	delete d_fir_original;
 }
 
@@ -738,15 +751,51 @@ bool MTFIRFilterFF_impl::stop() {
 void
 MTFIRFilterFF_impl::set_taps(const std::vector<float> &taps)
 {
-	gr::thread::scoped_lock l(d_setlock);
-	d_fir->set_taps(taps);
-	d_updated = true;
+	// Only the standby filter is touched here, so the stream keeps running on the
+	// current taps while the new set (aligned copies, sub-filters, FFT) is built.
+	gr::thread::scoped_lock l(d_updateLock);
+
+	d_standby->setTaps(taps);
+	d_standby->prepareTaps();
+	d_currentTaps = taps;
+	d_tapsPending = true;
 }
 
 std::vector<float>
 MTFIRFilterFF_impl::taps() const
 {
-	return d_fir->taps();
+	gr::thread::scoped_lock l(d_updateLock);
+
+	return d_currentTaps;
+}
+
+void
+MTFIRFilterFF_impl::applyPendingUpdates()
+{
+	// If set_taps is still building the standby set, just pick it up next call.
+	boost::unique_lock<gr::thread::mutex> l(d_updateLock, boost::try_to_lock);
+
+	if (!l.owns_lock())
+		return;
+
+	if (d_pendingThreads > 0) {
+		d_fir->setThreads(d_pendingThreads);
+		d_pendingThreads = 0;
+	}
+
+	if (!d_tapsPending)
+		return;
+
+	if (d_standby->ntaps() > (long)history()) {
+		// Longer filter: ask for the extra history and keep filtering with the current
+		// taps until it arrives.  History is never reduced, shorter filters just skip
+		// the leading samples.
+		set_history(d_standby->ntaps());
+		return;
+	}
+
+	d_fir->swapTaps(*d_standby);
+	d_tapsPending = false;
 }
 
 int
@@ -775,14 +824,24 @@ MTFIRFilterFF_impl::work_test(int noutput_items,
 		gr_vector_const_void_star &input_items,
 		gr_vector_void_star &output_items)
 {
-	gr::thread::scoped_lock l(d_setlock);
+	// The input for this call was sized for the current history, so take it before
+	// applyPendingUpdates can raise it.  History may be longer than the filter in use.
+	long callHistory = history();
 
-	const float *in = (const float *) input_items[0];
+	applyPendingUpdates();
+
+	const float *in = (const float *) input_items[0] + (callHistory - d_fir->ntaps());
 	float *out = (float *) output_items[0];
 
-	if (d_ndecimation == 1) {
+	if (d_fir->useFFT(noutput_items, d_ndecimation)) {
+		d_fir->filterNFFT(out, in, noutput_items, d_ndecimation);
+	}
+	else if (d_ndecimation == 1) {
 		d_fir->filterN(out, in, noutput_items);
 	}
+	else if (d_polyphase) {
+		d_fir->filterNdecPolyphase(out, in, noutput_items, d_ndecimation);
+	}
 	else {
 		d_fir->filterNdec(out, in, noutput_items, d_ndecimation);
 	}
@@ -797,20 +856,24 @@ MTFIRFilterFF_impl::work(int noutput_items,
 		gr_vector_const_void_star &input_items,
 		gr_vector_void_star &output_items)
 {
-	gr::thread::scoped_lock l(d_setlock);
+	// The input for this call was sized for the current history, so take it before
+	// applyPendingUpdates can raise it.  History may be longer than the filter in use.
+	long callHistory = history();
 
-	if (d_updated) {
-		set_history(d_fir->ntaps());
-		d_updated = false;
-		return 0;	     // history requirements may have changed.
-	}
+	applyPendingUpdates();
 
-	const float *in = (const float *) input_items[0];
+	const float *in = (const float *) input_items[0] + (callHistory - d_fir->ntaps());
 	float *out = (float *) output_items[0];
 
-	if (d_ndecimation == 1) {
+	if (d_fir->useFFT(noutput_items, d_ndecimation)) {
+		d_fir->filterNFFT(out, in, noutput_items, d_ndecimation);
+	}
+	else if (d_ndecimation == 1) {
 		d_fir->filterN(out, in, noutput_items);
 	}
+	else if (d_polyphase) {
+		d_fir->filterNdecPolyphase(out, in, noutput_items, d_ndecimation);
+	}
 	else {
 		d_fir->filterNdec(out, in, noutput_items, d_ndecimation);
 	}
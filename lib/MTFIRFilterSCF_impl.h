@@ -0,0 +1,55 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_LFAST_MTFIRFILTERSCF_IMPL_H
+#define INCLUDED_LFAST_MTFIRFILTERSCF_IMPL_H
+
+#include <lfast/MTFIRFilterSCF.h>
+#include "fir_filter_lfast.h"
+
+namespace gr {
+  namespace lfast {
+
+    class MTFIRFilterSCF_impl : public MTFIRFilterSCF
+    {
+     private:
+        gr::lfast::FIRFilterSCS_MT *d_fir;
+        int d_ndecimation;
+        bool d_updated;
+
+     public:
+      MTFIRFilterSCF_impl(int decimation, const std::vector<short> &taps, int nthreads, float scale, int affinity=0, const std::vector<int> &cores=std::vector<int>());
+      virtual ~MTFIRFilterSCF_impl();
+
+      void setThreads(int nthreads) { gr::thread::scoped_lock l(d_setlock); d_fir->setThreads(nthreads); };
+
+      void set_taps(const std::vector<short> &taps);
+      std::vector<short> taps() const;
+
+      // Where all the action really happens
+      int work(int noutput_items,
+         gr_vector_const_void_star &input_items,
+         gr_vector_void_star &output_items);
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_MTFIRFILTERSCF_IMPL_H */
@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gnuradio/io_signature.h>
+#include "MTFIRFilterSCS_impl.h"
+#include <volk/volk.h>
+
+namespace gr {
+namespace lfast {
+MTFIRFilterSCS::sptr
+MTFIRFilterSCS::make(int decimation, const std::vector<short>& taps, int nthreads, int shift, int affinity, const std::vector<int> &cores)
+{
+	return gnuradio::make_block_sptr<MTFIRFilterSCS_impl>(decimation, taps, nthreads, shift, affinity, cores);
+}
+
+/*
+ * The private constructor
+ */
+MTFIRFilterSCS_impl::MTFIRFilterSCS_impl(int decimation, const std::vector<short> &taps, int nthreads, int shift, int affinity, const std::vector<int> &cores)
+: gr::sync_decimator("MTFIRFilterSCS",
+		gr::io_signature::make(1, 1, sizeof(lv_16sc_t)),
+		gr::io_signature::make(1, 1, sizeof(lv_16sc_t)), decimation)
+{
+	if (decimation < 1)
+		throw std::out_of_range("MTFIRFilterSCS: decimation must be > 0");
+
+	d_fir = new gr::lfast::FIRFilterSCS_MT(taps,nthreads);
+	d_fir->setAffinity(affinity,cores);
+	d_fir->setShift(shift);
+	d_fir->setDecimation(decimation);
+	d_ndecimation = decimation;
+	d_updated = false;
+	set_history(d_fir->ntaps());
+
+	const int alignment_multiple =
+			volk_get_alignment() / sizeof(lv_16sc_t);
+	set_alignment(std::max(1, alignment_multiple));
+
+	gr::block::set_output_multiple(2048*nthreads);
+}
+
+/*
+ * Our virtual destructor.
+ */
+MTFIRFilterSCS_impl::~MTFIRFilterSCS_impl()
+{
+	delete d_fir;
+}
+
+void
+MTFIRFilterSCS_impl::set_taps(const std::vector<short> &taps)
+{
+	gr::thread::scoped_lock l(d_setlock);
+	d_fir->set_taps(taps);
+	d_updated = true;
+}
+
+std::vector<short>
+MTFIRFilterSCS_impl::taps() const
+{
+	return d_fir->taps();
+}
+
+int
+MTFIRFilterSCS_impl::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	gr::thread::scoped_lock l(d_setlock);
+
+	if (d_updated) {
+		set_history(d_fir->ntaps());
+		d_updated = false;
+		return 0;	     // history requirements may have changed.
+	}
+
+	const lv_16sc_t *in = (const lv_16sc_t *) input_items[0];
+	lv_16sc_t *out = (lv_16sc_t *) output_items[0];
+
+	d_fir->filterNdec(out, in, noutput_items, d_ndecimation);
+
+	// Tell runtime system how many output items we produced.
+	return noutput_items;
+}
+
+} /* namespace lfast */
+} /* namespace gr */
@@ -0,0 +1,110 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include <gnuradio/io_signature.h>
+#include "MTFilterChainCCF_impl.h"
+#include <volk/volk.h>
+
+namespace gr {
+namespace lfast {
+MTFilterChainCCF::sptr
+MTFilterChainCCF::make(int nthreads, int affinity, const std::vector<int> &cores)
+{
+	return gnuradio::make_block_sptr<MTFilterChainCCF_impl>(nthreads, affinity, cores);
+}
+
+/*
+ * The private constructor
+ */
+MTFilterChainCCF_impl::MTFilterChainCCF_impl(int nthreads, int affinity, const std::vector<int> &cores)
+: gr::sync_decimator("MTFilterChainCCF",
+		gr::io_signature::make(1, 1, sizeof(gr_complex)),
+		gr::io_signature::make(1, 1, sizeof(gr_complex)), 1)
+{
+	d_chain = new gr::lfast::FilterChainCCF(nthreads);
+	d_chain->setAffinity(affinity,cores);
+
+	const int alignment_multiple =
+			volk_get_alignment() / sizeof(gr_complex);
+	set_alignment(std::max(1, alignment_multiple));
+}
+
+/*
+ * Our virtual destructor.
+ */
+MTFilterChainCCF_impl::~MTFilterChainCCF_impl()
+{
+	delete d_chain;
+}
+
+void
+MTFilterChainCCF_impl::updateRates()
+{
+	set_decimation(d_chain->decimation());
+	set_history(d_chain->historyRequired() + 1);
+}
+
+void
+MTFilterChainCCF_impl::add_fir(const std::vector<float> &taps, int decimation)
+{
+	if (taps.empty())
+		return;
+
+	gr::thread::scoped_lock l(d_setlock);
+	d_chain->addFIR(taps, decimation);
+	updateRates();
+}
+
+void
+MTFilterChainCCF_impl::add_rotator(double phase_inc)
+{
+	if (phase_inc == 0.0)
+		return;
+
+	gr::thread::scoped_lock l(d_setlock);
+	d_chain->addRotator(phase_inc);
+}
+
+void
+MTFilterChainCCF_impl::add_agc(float rate, float reference, float gain, float max_gain)
+{
+	gr::thread::scoped_lock l(d_setlock);
+	d_chain->addAGC(rate, reference, gain, max_gain);
+}
+
+int
+MTFilterChainCCF_impl::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	gr::thread::scoped_lock l(d_setlock);
+
+	const gr_complex *in = (const gr_complex *) input_items[0];
+	gr_complex *out = (gr_complex *) output_items[0];
+
+	d_chain->filterN(out, in, noutput_items);
+
+	// Tell runtime system how many output items we produced.
+	return noutput_items;
+}
+
+} /* namespace lfast */
+} /* namespace gr */
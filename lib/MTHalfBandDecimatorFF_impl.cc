@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gnuradio/io_signature.h>
+#include "MTHalfBandDecimatorFF_impl.h"
+#include <volk/volk.h>
+
+namespace gr {
+namespace lfast {
+MTHalfBandDecimatorFF::sptr
+MTHalfBandDecimatorFF::make(const std::vector<float>& taps, int stages, int nthreads, int affinity, const std::vector<int> &cores)
+{
+	return gnuradio::make_block_sptr<MTHalfBandDecimatorFF_impl>(taps, stages, nthreads, affinity, cores);
+}
+
+/*
+ * The private constructor
+ */
+MTHalfBandDecimatorFF_impl::MTHalfBandDecimatorFF_impl(const std::vector<float> &taps, int stages, int nthreads, int affinity, const std::vector<int> &cores)
+: gr::sync_decimator("MTHalfBandDecimatorFF",
+		gr::io_signature::make(1, 1, sizeof(float)),
+		gr::io_signature::make(1, 1, sizeof(float)), 1 << std::max(1, stages))
+{
+	if (stages < 1)
+		throw std::out_of_range("MTHalfBandDecimatorFF: stages must be > 0");
+
+	if (!gr::lfast::HalfBandDecimatorFFF::isHalfBand(taps))
+		throw std::invalid_argument("MTHalfBandDecimatorFF: taps must be odd-length half-band taps");
+
+	d_fir = new gr::lfast::HalfBandDecimatorFFF(taps, stages, nthreads);
+	d_fir->setAffinity(affinity,cores);
+	d_updated = false;
+	set_history(d_fir->historyRequired() + 1);
+
+	const int alignment_multiple =
+			volk_get_alignment() / sizeof(float);
+	set_alignment(std::max(1, alignment_multiple));
+
+	gr::block::set_output_multiple(std::max(1, 2048*nthreads / d_fir->decimation()));
+}
+
+/*
+ * Our virtual destructor.
+ */
+MTHalfBandDecimatorFF_impl::~MTHalfBandDecimatorFF_impl()
+{
+	delete d_fir;
+}
+
+void
+MTHalfBandDecimatorFF_impl::set_taps(const std::vector<float> &taps)
+{
+	gr::thread::scoped_lock l(d_setlock);
+	d_fir->set_taps(taps);
+	d_updated = true;
+}
+
+std::vector<float>
+MTHalfBandDecimatorFF_impl::taps() const
+{
+	return d_fir->taps();
+}
+
+int
+MTHalfBandDecimatorFF_impl::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	gr::thread::scoped_lock l(d_setlock);
+
+	if (d_updated) {
+		set_history(d_fir->historyRequired() + 1);
+		d_updated = false;
+		return 0;	     // history requirements may have changed.
+	}
+
+	const float *in = (const float *) input_items[0];
+	float *out = (float *) output_items[0];
+
+	d_fir->filterN(out, in, noutput_items);
+
+	// Tell runtime system how many output items we produced.
+	return noutput_items;
+}
+
+} /* namespace lfast */
+} /* namespace gr */
@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gnuradio/io_signature.h>
+#include "MTInterpFIRFilterCCC_impl.h"
+#include <volk/volk.h>
+
+namespace gr {
+namespace lfast {
+MTInterpFIRFilterCCC::sptr
+MTInterpFIRFilterCCC::make(int interpolation, const std::vector<gr_complex>& taps, int nthreads, int affinity, const std::vector<int> &cores)
+{
+	return gnuradio::make_block_sptr<MTInterpFIRFilterCCC_impl>(interpolation, taps, nthreads, affinity, cores);
+}
+
+/*
+ * The private constructor
+ */
+MTInterpFIRFilterCCC_impl::MTInterpFIRFilterCCC_impl(int interpolation, const std::vector<gr_complex> &taps, int nthreads, int affinity, const std::vector<int> &cores)
+: gr::sync_interpolator("MTInterpFIRFilterCCC",
+		gr::io_signature::make(1, 1, sizeof(gr_complex)),
+		gr::io_signature::make(1, 1, sizeof(gr_complex)), interpolation)
+{
+	if (interpolation < 1)
+		throw std::out_of_range("MTInterpFIRFilterCCC: interpolation must be > 0");
+
+	d_fir = new gr::lfast::PolyphaseResamplerCCC(interpolation, 1, taps, nthreads);
+	d_fir->setAffinity(affinity,cores);
+	d_updated = false;
+	set_history(d_fir->ntaps());
+
+	const int alignment_multiple =
+			volk_get_alignment() / sizeof(gr_complex);
+	set_alignment(std::max(1, alignment_multiple));
+
+	// Keep enough work per call to spread across the threads, in whole input samples.
+	int outputMultiple = ((2048*nthreads + interpolation - 1) / interpolation) * interpolation;
+	gr::block::set_output_multiple(outputMultiple);
+}
+
+/*
+ * Our virtual destructor.
+ */
+MTInterpFIRFilterCCC_impl::~MTInterpFIRFilterCCC_impl()
+{
+	delete d_fir;
+}
+
+void
+MTInterpFIRFilterCCC_impl::set_taps(const std::vector<gr_complex> &taps)
+{
+	gr::thread::scoped_lock l(d_setlock);
+	d_fir->set_taps(taps);
+	d_updated = true;
+}
+
+std::vector<gr_complex>
+MTInterpFIRFilterCCC_impl::taps() const
+{
+	return d_fir->taps();
+}
+
+int
+MTInterpFIRFilterCCC_impl::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	gr::thread::scoped_lock l(d_setlock);
+
+	if (d_updated) {
+		set_history(d_fir->ntaps());
+		d_updated = false;
+		return 0;	     // history requirements may have changed.
+	}
+
+	const gr_complex *in = (const gr_complex *) input_items[0];
+	gr_complex *out = (gr_complex *) output_items[0];
+
+	// noutput_items is a multiple of the interpolation, so every call starts on sub-filter 0.
+	d_fir->filterN(out, in, noutput_items, 0);
+
+	// Tell runtime system how many output items we produced.
+	return noutput_items;
+}
+
+} /* namespace lfast */
+} /* namespace gr */
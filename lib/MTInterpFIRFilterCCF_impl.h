@@ -0,0 +1,54 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_LFAST_MTINTERPFIRFILTERCCF_IMPL_H
+#define INCLUDED_LFAST_MTINTERPFIRFILTERCCF_IMPL_H
+
+#include <lfast/MTInterpFIRFilterCCF.h>
+#include "fir_filter_lfast.h"
+
+namespace gr {
+  namespace lfast {
+
+    class MTInterpFIRFilterCCF_impl : public MTInterpFIRFilterCCF
+    {
+     private:
+        gr::lfast::PolyphaseResamplerCCF *d_fir;
+        bool d_updated;
+
+     public:
+      MTInterpFIRFilterCCF_impl(int interpolation, const std::vector<float> &taps, int nthreads, int affinity=0, const std::vector<int> &cores=std::vector<int>());
+      virtual ~MTInterpFIRFilterCCF_impl();
+
+      void setThreads(int nthreads) { gr::thread::scoped_lock l(d_setlock); d_fir->setThreads(nthreads); };
+
+      void set_taps(const std::vector<float> &taps);
+      std::vector<float> taps() const;
+
+      // Where all the action really happens
+      int work(int noutput_items,
+         gr_vector_const_void_star &input_items,
+         gr_vector_void_star &output_items);
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_MTINTERPFIRFILTERCCF_IMPL_H */
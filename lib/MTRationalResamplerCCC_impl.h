@@ -0,0 +1,63 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_LFAST_MTRATIONALRESAMPLERCCC_IMPL_H
+#define INCLUDED_LFAST_MTRATIONALRESAMPLERCCC_IMPL_H
+
+#include <lfast/MTRationalResamplerCCC.h>
+#include "fir_filter_lfast.h"
+
+namespace gr {
+  namespace lfast {
+
+    class MTRationalResamplerCCC_impl : public MTRationalResamplerCCC
+    {
+     private:
+        gr::lfast::PolyphaseResamplerCCC *d_fir;
+        bool d_updated;
+        unsigned d_interpolation;
+        unsigned d_decimation;
+        // Sub-filter the next output starts on
+        long d_ctr;
+
+     public:
+      MTRationalResamplerCCC_impl(int interpolation, int decimation, const std::vector<gr_complex> &taps, int nthreads, int affinity=0, const std::vector<int> &cores=std::vector<int>());
+      virtual ~MTRationalResamplerCCC_impl();
+
+      void setThreads(int nthreads) { gr::thread::scoped_lock l(d_setlock); d_fir->setThreads(nthreads); };
+
+      void set_taps(const std::vector<gr_complex> &taps);
+      std::vector<gr_complex> taps() const;
+
+      unsigned interpolation() const { return d_interpolation; };
+      unsigned decimation() const { return d_decimation; };
+
+      void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+           gr_vector_int &ninput_items,
+           gr_vector_const_void_star &input_items,
+           gr_vector_void_star &output_items);
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_MTRATIONALRESAMPLERCCC_IMPL_H */
@@ -0,0 +1,135 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gnuradio/io_signature.h>
+#include "MTRationalResamplerFF_impl.h"
+#include <volk/volk.h>
+
+namespace gr {
+namespace lfast {
+MTRationalResamplerFF::sptr
+MTRationalResamplerFF::make(int interpolation, int decimation, const std::vector<float>& taps, int nthreads, int affinity, const std::vector<int> &cores)
+{
+	return gnuradio::make_block_sptr<MTRationalResamplerFF_impl>(interpolation, decimation, taps, nthreads, affinity, cores);
+}
+
+/*
+ * The private constructor
+ */
+MTRationalResamplerFF_impl::MTRationalResamplerFF_impl(int interpolation, int decimation, const std::vector<float> &taps, int nthreads, int affinity, const std::vector<int> &cores)
+: gr::block("MTRationalResamplerFF",
+		gr::io_signature::make(1, 1, sizeof(float)),
+		gr::io_signature::make(1, 1, sizeof(float)))
+{
+	if (interpolation < 1)
+		throw std::out_of_range("MTRationalResamplerFF: interpolation must be > 0");
+
+	if (decimation < 1)
+		throw std::out_of_range("MTRationalResamplerFF: decimation must be > 0");
+
+	d_interpolation = interpolation;
+	d_decimation = decimation;
+	d_ctr = 0;
+
+	d_fir = new gr::lfast::PolyphaseResamplerFFF(interpolation, decimation, taps, nthreads);
+	d_fir->setAffinity(affinity,cores);
+	d_updated = false;
+	set_history(d_fir->ntaps());
+
+	set_relative_rate((uint64_t)interpolation, (uint64_t)decimation);
+
+	const int alignment_multiple =
+			volk_get_alignment() / sizeof(float);
+	set_alignment(std::max(1, alignment_multiple));
+
+	gr::block::set_output_multiple(2048*nthreads);
+}
+
+/*
+ * Our virtual destructor.
+ */
+MTRationalResamplerFF_impl::~MTRationalResamplerFF_impl()
+{
+	delete d_fir;
+}
+
+void
+MTRationalResamplerFF_impl::set_taps(const std::vector<float> &taps)
+{
+	gr::thread::scoped_lock l(d_setlock);
+	d_fir->set_taps(taps);
+	d_updated = true;
+}
+
+std::vector<float>
+MTRationalResamplerFF_impl::taps() const
+{
+	return d_fir->taps();
+}
+
+void
+MTRationalResamplerFF_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required)
+{
+	int nreqd = std::max(1, (int)((double)(noutput_items + 1) * d_decimation / d_interpolation) + (int)history() - 1);
+
+	unsigned ninputs = ninput_items_required.size();
+	for (unsigned i = 0; i < ninputs; i++)
+		ninput_items_required[i] = nreqd;
+}
+
+int
+MTRationalResamplerFF_impl::general_work(int noutput_items,
+		gr_vector_int &ninput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	gr::thread::scoped_lock l(d_setlock);
+
+	if (d_updated) {
+		set_history(d_fir->ntaps());
+		d_updated = false;
+		return 0;	     // history requirements may have changed.
+	}
+
+	const float *in = (const float *) input_items[0];
+	float *out = (float *) output_items[0];
+
+	long nOutputs = d_fir->outputsAvailable(ninput_items[0], d_ctr);
+
+	if (nOutputs > noutput_items)
+		nOutputs = noutput_items;
+
+	if (nOutputs <= 0)
+		return 0;
+
+	d_fir->filterN(out, in, nOutputs, d_ctr);
+
+	// Advance past the inputs used and carry the sub-filter phase into the next call.
+	long position = d_ctr + nOutputs * d_decimation;
+	d_ctr = position % d_interpolation;
+
+	consume_each(position / d_interpolation);
+
+	// Tell runtime system how many output items we produced.
+	return nOutputs;
+}
+
+} /* namespace lfast */
+} /* namespace gr */
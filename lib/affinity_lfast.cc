@@ -0,0 +1,231 @@
+/*
+ * affinity_lfast.cc
+ *
+ *      Copyright 2019, Michael Piscopo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "affinity_lfast.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sched.h>
+#include <pthread.h>
+#include <dirent.h>
+#endif
+
+namespace gr {
+  namespace lfast {
+	std::vector<int> allowedCpus() {
+		std::vector<int> cpus;
+#ifdef __linux__
+		cpu_set_t cpuSet;
+
+		CPU_ZERO(&cpuSet);
+
+		if (sched_getaffinity(0,sizeof(cpuSet),&cpuSet) != 0)
+			return cpus;
+
+		for (int i=0;i<CPU_SETSIZE;i++) {
+			if (CPU_ISSET(i,&cpuSet))
+				cpus.push_back(i);
+		}
+#endif
+		return cpus;
+	}
+
+#ifdef __linux__
+	static int readSysfsInt(const char *path) {
+		FILE *f = fopen(path,"r");
+
+		if (!f)
+			return -1;
+
+		int value = -1;
+
+		if (fscanf(f,"%d",&value) != 1)
+			value = -1;
+
+		fclose(f);
+
+		return value;
+	}
+#endif
+
+	int currentCpu() {
+#ifdef __linux__
+		return sched_getcpu();
+#else
+		return -1;
+#endif
+	}
+
+	int socketOfCpu(int cpu) {
+#ifdef __linux__
+		char path[128];
+
+		snprintf(path,sizeof(path),"/sys/devices/system/cpu/cpu%d/topology/physical_package_id",cpu);
+
+		return readSysfsInt(path);
+#else
+		return -1;
+#endif
+	}
+
+	int numaNodeOfCpu(int cpu) {
+#ifdef __linux__
+		// cpuN has a nodeM link for the node it belongs to
+		char path[128];
+
+		snprintf(path,sizeof(path),"/sys/devices/system/cpu/cpu%d",cpu);
+
+		DIR *dir = opendir(path);
+
+		if (!dir)
+			return -1;
+
+		int node = -1;
+		struct dirent *entry;
+
+		while ((entry = readdir(dir)) != NULL) {
+			int value;
+
+			if ((strncmp(entry->d_name,"node",4) == 0) && (sscanf(entry->d_name + 4,"%d",&value) == 1)) {
+				node = value;
+				break;
+			}
+		}
+
+		closedir(dir);
+
+		// Single-node kernels may not expose the links
+		if ((node < 0) && (cpu >= 0))
+			node = 0;
+
+		return node;
+#else
+		return -1;
+#endif
+	}
+
+	std::vector<int> socketCpus(int cpu) {
+		std::vector<int> cpus;
+#ifdef __linux__
+		int socket = socketOfCpu(cpu);
+
+		if (socket < 0)
+			return cpus;
+
+		std::vector<int> allowed = allowedCpus();
+
+		for (size_t i=0;i<allowed.size();i++) {
+			if (socketOfCpu(allowed[i]) == socket)
+				cpus.push_back(allowed[i]);
+		}
+#endif
+		return cpus;
+	}
+
+	std::vector<int> numaNodeCpus(int cpu) {
+		std::vector<int> cpus;
+#ifdef __linux__
+		int node = numaNodeOfCpu(cpu);
+
+		if (node < 0)
+			return cpus;
+
+		std::vector<int> allowed = allowedCpus();
+
+		for (size_t i=0;i<allowed.size();i++) {
+			if (numaNodeOfCpu(allowed[i]) == node)
+				cpus.push_back(allowed[i]);
+		}
+#endif
+		return cpus;
+	}
+
+	bool setThreadAffinity(boost::thread *thread, const std::vector<int> &cpus) {
+#ifdef __linux__
+		if (!thread || cpus.empty())
+			return false;
+
+		cpu_set_t cpuSet;
+
+		CPU_ZERO(&cpuSet);
+
+		for (size_t i=0;i<cpus.size();i++) {
+			if ((cpus[i] >= 0) && (cpus[i] < CPU_SETSIZE))
+				CPU_SET(cpus[i],&cpuSet);
+		}
+
+		return pthread_setaffinity_np(thread->native_handle(),sizeof(cpuSet),&cpuSet) == 0;
+#else
+		return false;
+#endif
+	}
+
+	std::vector<std::vector<int> > workerCpuSets(int policy, const std::vector<int> &cores, int numWorkers) {
+		std::vector<std::vector<int> > cpuSets;
+
+		if ((policy == LFAST_AFFINITY_NONE) || (numWorkers < 1))
+			return cpuSets;
+
+		if (policy == LFAST_AFFINITY_CORES) {
+			if (cores.empty())
+				return cpuSets;
+
+			for (int i=0;i<numWorkers;i++)
+				cpuSets.push_back(std::vector<int>(1,cores[i % cores.size()]));
+
+			return cpuSets;
+		}
+
+		int cpu = currentCpu();
+
+		if (cpu < 0)
+			return cpuSets;
+
+		if (policy == LFAST_AFFINITY_SAME_SOCKET) {
+			std::vector<int> cpus = socketCpus(cpu);
+
+			if (!cpus.empty())
+				cpuSets.assign(numWorkers,cpus);
+
+			return cpuSets;
+		}
+
+		if (policy == LFAST_AFFINITY_NUMA_NODE) {
+			std::vector<int> cpus = numaNodeCpus(cpu);
+
+			if (cpus.empty())
+				return cpuSets;
+
+			// Start just after the block thread's CPU so it's the last one doubled up on
+			std::vector<int>::iterator blockCpu = std::find(cpus.begin(),cpus.end(),cpu);
+
+			if (blockCpu != cpus.end())
+				std::rotate(cpus.begin(),blockCpu + 1,cpus.end());
+
+			for (int i=0;i<numWorkers;i++)
+				cpuSets.push_back(std::vector<int>(1,cpus[i % cpus.size()]));
+		}
+
+		return cpuSets;
+	}
+  } // end lfast
+} // end gr
@@ -0,0 +1,63 @@
+/*
+ * affinity_lfast.h
+ *
+ *      Copyright 2019, Michael Piscopo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIB_AFFINITY_LFAST_H_
+#define LIB_AFFINITY_LFAST_H_
+
+#include <boost/thread/thread.hpp>
+#include <vector>
+
+// Worker thread placement policies
+// NONE: threads float.  CORES: worker i is pinned to cores[(i-1) % cores.size()].
+// SAME_SOCKET: workers may run on any CPU of the socket the block thread is on.
+// NUMA_NODE: workers are pinned one per CPU of the block thread's NUMA node, block thread's CPU last.
+#define LFAST_AFFINITY_NONE 0
+#define LFAST_AFFINITY_CORES 1
+#define LFAST_AFFINITY_SAME_SOCKET 2
+#define LFAST_AFFINITY_NUMA_NODE 3
+
+namespace gr {
+  namespace lfast {
+	/*
+	 * CPU topology and pinning helpers.  Topology comes from sysfs (the same source libnuma's
+	 * numa_node_of_cpu uses), limited to the CPUs this process may run on.
+	 * Everything returns -1 / empty / false where it isn't supported (non-Linux).
+	 */
+	int currentCpu();
+	std::vector<int> allowedCpus();
+	int numaNodeOfCpu(int cpu);
+	int socketOfCpu(int cpu);
+
+	// CPUs this process is allowed on that share cpu's socket (or NUMA node)
+	std::vector<int> socketCpus(int cpu);
+	std::vector<int> numaNodeCpus(int cpu);
+
+	// Restricts thread to cpus (all of them, not one each)
+	bool setThreadAffinity(boost::thread *thread, const std::vector<int> &cpus);
+
+	/*
+	 * Resolves a policy into per-worker CPU sets for workers 1..numWorkers, relative to the
+	 * CPU the calling thread is on now (so call it from the block thread).
+	 * Returns an empty vector for LFAST_AFFINITY_NONE or if the topology can't be read.
+	 */
+	std::vector<std::vector<int> > workerCpuSets(int policy, const std::vector<int> &cores, int numWorkers);
+  } // end lfast
+} // end gr
+
+#endif /* LIB_AFFINITY_LFAST_H_ */
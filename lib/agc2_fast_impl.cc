@@ -0,0 +1,126 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gnuradio/io_signature.h>
+#include "agc2_fast_impl.h"
+#include <volk/volk.h>
+#include "scomplex.h"
+
+// assisted detection of Fused Multiply Add (FMA) functionality
+#if !defined(__FMA__) && defined(__AVX2__)
+#define __FMA__ 1
+#endif
+
+#if defined(FP_FAST_FMA)
+#define __FMA__ 1
+#endif
+
+#if defined(__FMA__)
+#pragma message "FMA support detected.  Compiling for Fused Multiply/Add support."
+#else
+#pragma message "No FMA support detected.  Compiling for normal math."
+#endif
+
+namespace gr {
+namespace lfast {
+
+agc2_fast::sptr agc2_fast::make(float attack_rate, float decay_rate, float reference, float gain)
+{
+	return gnuradio::make_block_sptr<agc2_fast_impl>(attack_rate, decay_rate, reference, gain);
+}
+
+/*
+ * The private constructor
+ */
+agc2_fast_impl::agc2_fast_impl(float attack_rate, float decay_rate, float reference, float gain)
+: gr::sync_block("agc2_fast",
+		io_signature::make(1, 1, sizeof(gr_complex)),
+		io_signature::make(1, 1, sizeof(gr_complex))),
+		kernel::agc2_cc(attack_rate, decay_rate, reference, gain, 65536)
+{
+	const int alignment_multiple =
+			volk_get_alignment() / sizeof(gr_complex);
+	set_alignment(std::max(1, alignment_multiple));
+}
+
+/*
+ * Our virtual destructor.
+ */
+agc2_fast_impl::~agc2_fast_impl()
+{
+}
+
+int
+agc2_fast_impl::work_original(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	const gr_complex *in = (const gr_complex*)input_items[0];
+	gr_complex *out = (gr_complex*)output_items[0];
+	scaleN(out, in, noutput_items);
+	return noutput_items;
+}
+
+int
+agc2_fast_impl::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	const gr_complex *in = (const gr_complex*)input_items[0];
+	gr_complex *out = (gr_complex*)output_items[0];
+	StructComplex *sOut = (StructComplex*)output_items[0];
+
+	float o_i,o_r;
+	float err,rate;
+
+	for (int i=0;i<noutput_items;i++) {
+		out[i] = in[i] * _gain;
+
+		// save on the n*(.imag() and .real()) function jumps
+		o_i = sOut[i].imag;
+		o_r = sOut[i].real;
+
+#if defined(__FMA__)
+		err = sqrtf(__builtin_fmaf(o_r,o_r,o_i*o_i)) - _reference;
+#else
+		err = sqrtf(o_r*o_r + o_i*o_i) - _reference;
+#endif
+
+		// Attack when the level error jumps past the current gain, as in scaleN
+		rate = (err > _gain) ? _attack_rate : _decay_rate;
+
+#if defined(__FMA__)
+		_gain = __builtin_fmaf(-err,rate,_gain);
+#else
+		_gain -= err*rate;
+#endif
+
+		if(_gain < 0.0f)
+			_gain = 10e-5;
+
+		if(_max_gain > 0.0 && _gain > _max_gain) {
+			_gain = _max_gain;
+		}
+	}
+	return noutput_items;
+}
+} /* namespace lfast */
+} /* namespace gr */
+
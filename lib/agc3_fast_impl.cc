@@ -0,0 +1,160 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gnuradio/io_signature.h>
+#include "agc3_fast_impl.h"
+#include <volk/volk.h>
+
+namespace gr {
+namespace lfast {
+
+agc3_fast::sptr agc3_fast::make(float attack_rate, float decay_rate, float reference, float gain, int iir_update_decim)
+{
+	return gnuradio::make_block_sptr<agc3_fast_impl>(attack_rate, decay_rate, reference, gain, iir_update_decim);
+}
+
+/*
+ * The private constructor
+ */
+agc3_fast_impl::agc3_fast_impl(float attack_rate, float decay_rate, float reference, float gain, int iir_update_decim)
+: gr::sync_block("agc3_fast",
+		io_signature::make(1, 1, sizeof(gr_complex)),
+		io_signature::make(1, 1, sizeof(gr_complex))),
+		kernel::agc3_cc(attack_rate, decay_rate, reference, gain, 65536, iir_update_decim)
+{
+	d_mag = NULL;
+	d_sample_gains = NULL;
+	d_scratch_size = 0;
+
+	const int alignment_multiple =
+			volk_get_alignment() / sizeof(gr_complex);
+	set_alignment(std::max(1, alignment_multiple));
+}
+
+/*
+ * Our virtual destructor.
+ */
+agc3_fast_impl::~agc3_fast_impl()
+{
+	if (d_mag) {
+		volk_free(d_mag);
+		d_mag = NULL;
+	}
+
+	if (d_sample_gains) {
+		volk_free(d_sample_gains);
+		d_sample_gains = NULL;
+	}
+}
+
+void agc3_fast_impl::reserve(int noutput_items) {
+	if (d_scratch_size >= noutput_items)
+		return;
+
+	if (d_mag)
+		volk_free(d_mag);
+
+	if (d_sample_gains)
+		volk_free(d_sample_gains);
+
+	size_t alignment = volk_get_alignment();
+	d_mag = (float *)volk_malloc(noutput_items*sizeof(float), alignment);
+	d_sample_gains = (float *)volk_malloc(noutput_items*sizeof(float), alignment);
+	d_scratch_size = noutput_items;
+}
+
+int
+agc3_fast_impl::work_original(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	const gr_complex *in = (const gr_complex*)input_items[0];
+	gr_complex *out = (gr_complex*)output_items[0];
+	scaleN(out, in, noutput_items);
+	return noutput_items;
+}
+
+int
+agc3_fast_impl::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	const gr_complex *in = (const gr_complex*)input_items[0];
+	gr_complex *out = (gr_complex*)output_items[0];
+
+	if (noutput_items < 1)
+		return 0;
+
+	reserve(noutput_items);
+
+	// Same results as scaleN, but the magnitudes and the scaling run through volk.
+	// Only the level recursion itself is left as a scalar loop.
+	bool needAllMagnitudes = _reset || (_iir_update_decim == 1);
+
+	if (needAllMagnitudes)
+		volk_32fc_magnitude_32f(d_mag, in, noutput_items);
+
+	if (_reset) {
+		float magSum;
+		volk_32f_accumulator_s32f(&magSum, d_mag, noutput_items);
+		acquire(magSum, noutput_items);
+	}
+
+	if (_iir_update_decim == 1) {
+		// kernel::agc3_cc::update in locals, so the gain buffer stores
+		// can't force _level and _gain to be reloaded every sample
+		float level = _level;
+		float gain = _gain;
+		float rate;
+
+		for (int i=0;i<noutput_items;i++) {
+			rate = (d_mag[i] > level) ? _attack_rate : _decay_rate;
+			level = level + rate * (d_mag[i] - level);
+
+			if (level > 0.0f)
+				gain = _reference / level;
+
+			if (_max_gain > 0.0 && gain > _max_gain)
+				gain = _max_gain;
+
+			d_sample_gains[i] = gain;
+		}
+
+		_level = level;
+		_gain = gain;
+
+		volk_32fc_32f_multiply_32fc(out, in, d_sample_gains, noutput_items);
+	}
+	else {
+		// The gain is constant between level updates
+		for (int start=0;start<noutput_items;start += _iir_update_decim) {
+			int len = std::min(_iir_update_decim, noutput_items - start);
+
+			update(needAllMagnitudes ? d_mag[start] : std::abs(in[start]));
+
+			volk_32fc_s32fc_multiply_32fc(&out[start], &in[start], lv_cmake(_gain, 0.0f), len);
+		}
+	}
+
+	return noutput_items;
+}
+} /* namespace lfast */
+} /* namespace gr */
+
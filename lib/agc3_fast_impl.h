@@ -0,0 +1,74 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_LFAST_AGC3_FAST_IMPL_H
+#define INCLUDED_LFAST_AGC3_FAST_IMPL_H
+
+#include <lfast/agc3_fast.h>
+
+namespace gr {
+  namespace lfast {
+
+    class agc3_fast_impl : public agc3_fast,kernel::agc3_cc
+    {
+     private:
+      // Magnitude and per-sample gain scratch
+      float *d_mag;
+      float *d_sample_gains;
+      int d_scratch_size;
+
+      void reserve(int noutput_items);
+
+     public:
+      agc3_fast_impl(float attack_rate = 1e-1, float decay_rate = 1e-2, float reference = 1.0,
+    		  float gain = 1.0, int iir_update_decim = 1);
+      ~agc3_fast_impl();
+
+      float attack_rate() const { return kernel::agc3_cc::attack_rate(); }
+      float decay_rate() const { return kernel::agc3_cc::decay_rate(); }
+      float reference() const { return kernel::agc3_cc::reference(); }
+      float gain() const { return kernel::agc3_cc::gain(); }
+      float max_gain() const { return kernel::agc3_cc::max_gain(); }
+
+      void set_attack_rate(float rate) { kernel::agc3_cc::set_attack_rate(rate); }
+      void set_decay_rate(float rate) { kernel::agc3_cc::set_decay_rate(rate); }
+      void set_reference(float reference) { kernel::agc3_cc::set_reference(reference); }
+      void set_gain(float gain) { kernel::agc3_cc::set_gain(gain); }
+      void set_max_gain(float max_gain) { kernel::agc3_cc::set_max_gain(max_gain); }
+
+      int iir_update_decim() const { return kernel::agc3_cc::iir_update_decim(); }
+      void reset() { kernel::agc3_cc::reset(); }
+
+      // Where all the action really happens
+      int work(int noutput_items,
+         gr_vector_const_void_star &input_items,
+         gr_vector_void_star &output_items);
+
+      // The plain kernel loop, for timing comparisons
+      int work_original(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_AGC3_FAST_IMPL_H */
+
@@ -54,6 +54,11 @@ agc_fast_ff_impl::agc_fast_ff_impl(float rate, float reference, float gain)
 		io_signature::make(1, 1, sizeof(float))),
 		gr::analog::kernel::agc_ff(rate, reference, gain, 65536)
 {
+	d_block_size = 0;
+	d_block_tolerance = 0.01;
+	d_mag = NULL;
+	d_mag_size = 0;
+
 	const int alignment_multiple =
 			volk_get_alignment() / sizeof(float);
 	set_alignment(std::max(1, alignment_multiple));
@@ -64,30 +69,89 @@ agc_fast_ff_impl::agc_fast_ff_impl(float rate, float reference, float gain)
  */
 agc_fast_ff_impl::~agc_fast_ff_impl()
 {
+	if (d_mag) {
+		volk_free(d_mag);
+		d_mag = NULL;
+	}
 }
 
-int
-agc_fast_ff_impl::work(int noutput_items,
-		gr_vector_const_void_star &input_items,
-		gr_vector_void_star &output_items)
-{
-	const float *in = (const float *)input_items[0];
-	float *out = (float *)output_items[0];
+void agc_fast_ff_impl::set_block_size(int block_size) {
+	if (block_size < 0)
+		block_size = 0;
 
+	d_block_size = block_size;
+}
+
+void agc_fast_ff_impl::set_block_tolerance(float tolerance) {
+	d_block_tolerance = std::abs(tolerance);
+}
+
+void agc_fast_ff_impl::scaleExact(float *out, const float *in, int noutput_items) {
 	for (int i=0;i<noutput_items;i++) {
 		out[i] = in[i] * _gain;
 
 #if defined(__FMA__)
-      			  _gain = __builtin_fmaf((_reference - std::abs(out[i])),_rate,_gain);
-      			  // _gain = (_reference - std::abs(out[i])) * _rate + _gain;
+		_gain = __builtin_fmaf((_reference - std::abs(out[i])),_rate,_gain);
 #else
-      			  _gain = (_reference - std::abs(out[i])) * _rate + _gain;
+		_gain = (_reference - std::abs(out[i])) * _rate + _gain;
 #endif
 
-      			  if(_max_gain > 0.0 && _gain > _max_gain)
-      				  _gain = _max_gain;
+		if(_max_gain > 0.0 && _gain > _max_gain)
+			_gain = _max_gain;
+	}
+}
 
+void agc_fast_ff_impl::scaleBlocks(float *out, const float *in, int noutput_items, int block_size) {
+	if (d_mag_size < block_size) {
+		if (d_mag)
+			volk_free(d_mag);
+
+		d_mag = (float *)volk_malloc(block_size*sizeof(float), volk_get_alignment());
+		d_mag_size = block_size;
 	}
+
+	for (int start=0;start<noutput_items;start += block_size) {
+		int len = std::min(block_size, noutput_items - start);
+
+		// |in| is the sign bit cleared.  Same one-step-per-sub-block update as the complex version.
+		for (int i=0;i<len;i++)
+			d_mag[i] = std::abs(in[start+i]);
+
+		float magSum;
+		volk_32f_accumulator_s32f(&magSum, d_mag, len);
+
+		float newGain = _gain + _rate * ((float)len * _reference - _gain * magSum);
+
+		if (std::abs(newGain - _gain) > d_block_tolerance * std::abs(_gain)) {
+			scaleExact(&out[start], &in[start], len);
+			continue;
+		}
+
+		volk_32f_s32f_multiply_32f(&out[start], &in[start], _gain, len);
+
+		_gain = newGain;
+
+		if(_max_gain > 0.0 && _gain > _max_gain)
+			_gain = _max_gain;
+	}
+}
+
+int
+agc_fast_ff_impl::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	const float *in = (const float *)input_items[0];
+	float *out = (float *)output_items[0];
+
+	// Read once so a concurrent set_block_size can't change it mid-call
+	int block_size = d_block_size;
+
+	if (block_size > 1)
+		scaleBlocks(out, in, noutput_items, block_size);
+	else
+		scaleExact(out, in, noutput_items);
+
 	return noutput_items;
 }
 
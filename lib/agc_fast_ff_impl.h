@@ -30,7 +30,16 @@ namespace gr {
     class agc_fast_ff_impl : public agc_fast_ff,gr::analog::kernel::agc_ff
     {
      private:
-      // Nothing to declare in this block.
+      // Block mode (0 = per-sample gain update)
+      int d_block_size;
+      float d_block_tolerance;
+
+      // Magnitude scratch for block mode
+      float *d_mag;
+      int d_mag_size;
+
+      void scaleExact(float *out, const float *in, int noutput_items);
+      void scaleBlocks(float *out, const float *in, int noutput_items, int block_size);
 
      public:
       agc_fast_ff_impl(float rate = 1e-4, float reference = 1.0,
@@ -47,6 +56,11 @@ namespace gr {
       void set_gain(float gain) { gr::analog::kernel::agc_ff::set_gain(gain); }
       virtual void set_max_gain(float max_gain) { gr::analog::kernel::agc_ff::set_max_gain(max_gain); }
 
+      virtual void set_block_size(int block_size);
+      virtual int block_size() const { return d_block_size; }
+      virtual void set_block_tolerance(float tolerance);
+      virtual float block_tolerance() const { return d_block_tolerance; }
+
       // Where all the action really happens
       int work(int noutput_items,
          gr_vector_const_void_star &input_items,
@@ -55,6 +55,11 @@ agc_fast_impl::agc_fast_impl(float rate, float reference, float gain)
 		io_signature::make(1, 1, sizeof(gr_complex))),
 		kernel::agc_cc(rate, reference, gain, 65536)
 {
+	d_block_size = 0;
+	d_block_tolerance = 0.01;
+	d_mag = NULL;
+	d_mag_size = 0;
+
 	const int alignment_multiple =
 			volk_get_alignment() / sizeof(gr_complex);
 	set_alignment(std::max(1, alignment_multiple));
@@ -65,6 +70,21 @@ agc_fast_impl::agc_fast_impl(float rate, float reference, float gain)
  */
 agc_fast_impl::~agc_fast_impl()
 {
+	if (d_mag) {
+		volk_free(d_mag);
+		d_mag = NULL;
+	}
+}
+
+void agc_fast_impl::set_block_size(int block_size) {
+	if (block_size < 0)
+		block_size = 0;
+
+	d_block_size = block_size;
+}
+
+void agc_fast_impl::set_block_tolerance(float tolerance) {
+	d_block_tolerance = std::abs(tolerance);
 }
 
 int
@@ -131,25 +151,10 @@ agc_fast_impl::work_test(int noutput_items,
 	return noutput_items;
 }
 
-int
-agc_fast_impl::work(int noutput_items,
-		gr_vector_const_void_star &input_items,
-		gr_vector_void_star &output_items)
-{
-	const gr_complex *in = (const gr_complex*)input_items[0];
-	gr_complex *out = (gr_complex*)output_items[0];
-	StructComplex *sOut = (StructComplex*)output_items[0];
+void agc_fast_impl::scaleExact(gr_complex *out, const gr_complex *in, int noutput_items) {
+	StructComplex *sOut = (StructComplex*)out;
 
 	float o_i,o_r;
-	/*
-        union
-        {
-          int i;
-          float x;
-        } u;
-	 */
-	float val,sqrt_val;
-	int *i_ptr;
 
 	for (int i=0;i<noutput_items;i++) {
 		out[i] = in[i] * _gain;
@@ -158,19 +163,6 @@ agc_fast_impl::work(int noutput_items,
 		o_i = sOut[i].imag;
 		o_r = sOut[i].real;
 
-		// See https://www.codeproject.com/Articles/69941/Best-Square-Root-Method-Algorithm-Function-Precisi
-		// for faster square root examples.
-		// Tried this one that should be 3x faster but in testing it ran considerably slower.
-		/*
-      	  val = sqrt_val = o_r*o_r + o_i*o_i;
-      	  i_ptr = (int *)&sqrt_val;
-		 *i_ptr = (1<<29) + (*i_ptr >> 1) - (1<<22);
-      	  sqrt_val = sqrt_val + val/sqrt_val;
-      	  sqrt_val = _reference - 0.25f*sqrt_val + val/sqrt_val;
-
-      	  // _gain += _rate * sqrt_val;
-		 */
-
 #if defined(__FMA__)
 		_gain =  _gain + _rate * (_reference - sqrt(__builtin_fmaf(o_r,o_r,o_i*o_i)));
 #else
@@ -182,8 +174,62 @@ agc_fast_impl::work(int noutput_items,
 		}
 
 	}
+}
+
+void agc_fast_impl::scaleBlocks(gr_complex *out, const gr_complex *in, int noutput_items, int block_size) {
+	if (d_mag_size < block_size) {
+		if (d_mag)
+			volk_free(d_mag);
+
+		d_mag = (float *)volk_malloc(block_size*sizeof(float), volk_get_alignment());
+		d_mag_size = block_size;
+	}
+
+	for (int start=0;start<noutput_items;start += block_size) {
+		int len = std::min(block_size, noutput_items - start);
+
+		// Holding the gain at g for the sub-block, the per-sample update
+		// g += rate*(reference - g*|in[i]|) sums to one step over the block.
+		volk_32fc_magnitude_32f(d_mag, &in[start], len);
+		float magSum;
+		volk_32f_accumulator_s32f(&magSum, d_mag, len);
+
+		float newGain = _gain + _rate * ((float)len * _reference - _gain * magSum);
+
+		if (std::abs(newGain - _gain) > d_block_tolerance * std::abs(_gain)) {
+			// Gain is moving too fast (acquisition, level steps) for a single value
+			// across this sub-block.  Run it sample by sample.
+			scaleExact(&out[start], &in[start], len);
+			continue;
+		}
+
+		volk_32fc_s32fc_multiply_32fc(&out[start], &in[start], lv_cmake(_gain, 0.0f), len);
+
+		_gain = newGain;
+
+		if(_max_gain > 0.0 && _gain > _max_gain) {
+			_gain = _max_gain;
+		}
+	}
+}
+
+int
+agc_fast_impl::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	const gr_complex *in = (const gr_complex*)input_items[0];
+	gr_complex *out = (gr_complex*)output_items[0];
+
+	// Read once so a concurrent set_block_size can't change it mid-call
+	int block_size = d_block_size;
+
+	if (block_size > 1)
+		scaleBlocks(out, in, noutput_items, block_size);
+	else
+		scaleExact(out, in, noutput_items);
+
 	return noutput_items;
 }
 } /* namespace lfast */
 } /* namespace gr */
-
@@ -29,7 +29,16 @@ namespace gr {
     class agc_fast_impl : public agc_fast,kernel::agc_cc
     {
      private:
-      // Nothing to declare in this block.
+      // Block mode (0 = per-sample gain update)
+      int d_block_size;
+      float d_block_tolerance;
+
+      // Magnitude scratch for block mode
+      float *d_mag;
+      int d_mag_size;
+
+      void scaleExact(gr_complex *out, const gr_complex *in, int noutput_items);
+      void scaleBlocks(gr_complex *out, const gr_complex *in, int noutput_items, int block_size);
 
      public:
       agc_fast_impl(float rate = 1e-4, float reference = 1.0,
@@ -46,6 +55,11 @@ namespace gr {
       void set_gain(float gain) { kernel::agc_cc::set_gain(gain); }
       virtual void set_max_gain(float max_gain) { kernel::agc_cc::set_max_gain(max_gain); }
 
+      virtual void set_block_size(int block_size);
+      virtual int block_size() const { return d_block_size; }
+      virtual void set_block_tolerance(float tolerance);
+      virtual float block_tolerance() const { return d_block_tolerance; }
+
       // Where all the action really happens
       int work(int noutput_items,
          gr_vector_const_void_star &input_items,
@@ -0,0 +1,205 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include <gnuradio/io_signature.h>
+#include "agc_fast_multi_impl.h"
+#include "fir_blocked_lfast.h"
+#include <volk/volk.h>
+#include <stdexcept>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LFAST_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace gr {
+namespace lfast {
+
+agc_fast_multi::sptr agc_fast_multi::make(int nchannels, float rate, float reference, float gain,
+		float max_gain, bool vector_input)
+{
+	return gnuradio::make_block_sptr<agc_fast_multi_impl>(nchannels, rate, reference, gain, max_gain, vector_input);
+}
+
+/*
+ * One channel's loop, the same update as agc_fast.  stride steps from one sample of the
+ * channel to the next (nchannels for vector input, 1 for a stream port).
+ */
+static void scaleChannel(gr_complex *out, const gr_complex *in, long stride, int noutput_items,
+		float &gain, float rate, float reference, float max_gain) {
+	float g = gain;
+
+	for (int i=0;i<noutput_items;i++) {
+		gr_complex o = in[i*stride] * g;
+		out[i*stride] = o;
+
+		g = g + rate * (reference - sqrtf(o.real()*o.real() + o.imag()*o.imag()));
+
+		if (max_gain > 0.0f && g > max_gain)
+			g = max_gain;
+	}
+
+	gain = g;
+}
+
+#if defined(LFAST_X86_KERNELS)
+/*
+ * Vector input: 8 channels per register.  The 8 complex samples of a frame span two
+ * registers, so the gains are spread to (g0,g0,g1,g1,...) for the multiply and the
+ * squared magnitudes are pulled back into channel order after the horizontal add.
+ * Returns how many channels (a multiple of 8) it handled.
+ */
+__attribute__((target("avx2,fma")))
+static int scaleFrames_avx2(gr_complex *out, const gr_complex *in, float *gains, int nchannels, int nframes,
+		float rate, float reference, float max_gain) {
+	int simdChannels = (nchannels / 8) * 8;
+
+	if (simdChannels == 0)
+		return 0;
+
+	const __m256i loIndex = _mm256_setr_epi32(0,0,1,1,2,2,3,3);
+	const __m256i hiIndex = _mm256_setr_epi32(4,4,5,5,6,6,7,7);
+	// hadd leaves the magnitudes as channels 0,1,4,5,2,3,6,7
+	const __m256i magIndex = _mm256_setr_epi32(0,1,4,5,2,3,6,7);
+
+	const __m256 vRate = _mm256_set1_ps(rate);
+	const __m256 vReference = _mm256_set1_ps(reference);
+	const __m256 vMaxGain = _mm256_set1_ps(max_gain);
+	bool clampGain = max_gain > 0.0f;
+
+	for (int f=0;f<nframes;f++) {
+		const float *inFrame = (const float *)&in[(long)f*nchannels];
+		float *outFrame = (float *)&out[(long)f*nchannels];
+
+		for (int c=0;c<simdChannels;c+=8) {
+			__m256 g = _mm256_loadu_ps(&gains[c]);
+
+			__m256 outLo = _mm256_mul_ps(_mm256_loadu_ps(inFrame + 2*c),_mm256_permutevar8x32_ps(g,loIndex));
+			__m256 outHi = _mm256_mul_ps(_mm256_loadu_ps(inFrame + 2*c + 8),_mm256_permutevar8x32_ps(g,hiIndex));
+			_mm256_storeu_ps(outFrame + 2*c,outLo);
+			_mm256_storeu_ps(outFrame + 2*c + 8,outHi);
+
+			__m256 magSq = _mm256_hadd_ps(_mm256_mul_ps(outLo,outLo),_mm256_mul_ps(outHi,outHi));
+			__m256 mag = _mm256_sqrt_ps(_mm256_permutevar8x32_ps(magSq,magIndex));
+
+			g = _mm256_fmadd_ps(vRate,_mm256_sub_ps(vReference,mag),g);
+
+			if (clampGain)
+				g = _mm256_min_ps(g,vMaxGain);
+
+			_mm256_storeu_ps(&gains[c],g);
+		}
+	}
+
+	return simdChannels;
+}
+#endif
+
+/*
+ * The private constructor
+ */
+agc_fast_multi_impl::agc_fast_multi_impl(int nchannels, float rate, float reference, float gain,
+		float max_gain, bool vector_input)
+: gr::sync_block("agc_fast_multi",
+		vector_input ? io_signature::make(1, 1, sizeof(gr_complex)*std::max(nchannels,1)) :
+				io_signature::make(std::max(nchannels,1), std::max(nchannels,1), sizeof(gr_complex)),
+		vector_input ? io_signature::make(1, 1, sizeof(gr_complex)*std::max(nchannels,1)) :
+				io_signature::make(std::max(nchannels,1), std::max(nchannels,1), sizeof(gr_complex))),
+		d_nchannels(nchannels), d_vector_input(vector_input),
+		d_rate(rate), d_reference(reference), d_max_gain(max_gain)
+{
+	if (nchannels < 1)
+		throw std::invalid_argument("agc_fast_multi: nchannels must be at least 1.");
+
+	d_gains = (float *)volk_malloc(nchannels*sizeof(float), volk_get_alignment());
+	set_gain(gain);
+}
+
+/*
+ * Our virtual destructor.
+ */
+agc_fast_multi_impl::~agc_fast_multi_impl()
+{
+	if (d_gains) {
+		volk_free(d_gains);
+		d_gains = NULL;
+	}
+}
+
+float agc_fast_multi_impl::gain(int channel) const {
+	if (channel < 0 || channel >= d_nchannels)
+		throw std::invalid_argument("agc_fast_multi: channel out of range.");
+
+	return d_gains[channel];
+}
+
+std::vector<float> agc_fast_multi_impl::gains() const {
+	return std::vector<float>(d_gains, d_gains + d_nchannels);
+}
+
+void agc_fast_multi_impl::set_gain(float gain) {
+	for (int c=0;c<d_nchannels;c++)
+		d_gains[c] = gain;
+}
+
+void agc_fast_multi_impl::set_channel_gain(int channel, float gain) {
+	if (channel < 0 || channel >= d_nchannels)
+		throw std::invalid_argument("agc_fast_multi: channel out of range.");
+
+	d_gains[channel] = gain;
+}
+
+int
+agc_fast_multi_impl::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	if (!d_vector_input) {
+		for (int c=0;c<d_nchannels;c++) {
+			scaleChannel((gr_complex *)output_items[c], (const gr_complex *)input_items[c], 1, noutput_items,
+					d_gains[c], d_rate, d_reference, d_max_gain);
+		}
+
+		return noutput_items;
+	}
+
+	const gr_complex *in = (const gr_complex*)input_items[0];
+	gr_complex *out = (gr_complex*)output_items[0];
+
+	int firstChannel = 0;
+
+#if defined(LFAST_X86_KERNELS)
+	if (blockedKernelLevel() >= LFAST_KERNEL_AVX2)
+		firstChannel = scaleFrames_avx2(out, in, d_gains, d_nchannels, noutput_items, d_rate, d_reference, d_max_gain);
+#endif
+
+	// Channels left over from the SIMD groups
+	for (int c=firstChannel;c<d_nchannels;c++) {
+		scaleChannel(&out[c], &in[c], d_nchannels, noutput_items,
+				d_gains[c], d_rate, d_reference, d_max_gain);
+	}
+
+	return noutput_items;
+}
+} /* namespace lfast */
+} /* namespace gr */
+
@@ -0,0 +1,72 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_LFAST_AGC_FAST_MULTI_IMPL_H
+#define INCLUDED_LFAST_AGC_FAST_MULTI_IMPL_H
+
+#include <lfast/agc_fast_multi.h>
+
+namespace gr {
+  namespace lfast {
+
+    class agc_fast_multi_impl : public agc_fast_multi
+    {
+     private:
+      int d_nchannels;
+      bool d_vector_input;
+
+      float d_rate;
+      float d_reference;
+      float d_max_gain;
+
+      // Per-channel gains, one contiguous aligned array so neighboring channels load as one vector
+      float *d_gains;
+
+     public:
+      agc_fast_multi_impl(int nchannels, float rate = 1e-4, float reference = 1.0, float gain = 1.0,
+    		  float max_gain = 65536.0, bool vector_input = true);
+      ~agc_fast_multi_impl();
+
+      int num_channels() const { return d_nchannels; }
+
+      float rate() const { return d_rate; }
+      float reference() const { return d_reference; }
+      float max_gain() const { return d_max_gain; }
+      float gain(int channel) const;
+      std::vector<float> gains() const;
+
+      void set_rate(float rate) { d_rate = rate; }
+      void set_reference(float reference) { d_reference = reference; }
+      void set_max_gain(float max_gain) { d_max_gain = max_gain; }
+      void set_gain(float gain);
+      void set_channel_gain(int channel, float gain);
+
+      // Where all the action really happens
+      int work(int noutput_items,
+         gr_vector_const_void_star &input_items,
+         gr_vector_void_star &output_items);
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_AGC_FAST_MULTI_IMPL_H */
+
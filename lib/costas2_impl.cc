@@ -29,6 +29,10 @@
 #include <gnuradio/expj.h>
 #include <gnuradio/math.h>
 #include "clSComplex.h"
+#include "nco_lfast.h"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
 
 #define CL_TWO_PI 6.28318530717958647692
 #define CL_ONE_OVER_2PI 0.15915494309189533577
@@ -67,7 +71,8 @@ costas2_impl::costas2_impl(float loop_bw, int order, bool genPDUs)
 		gr::io_signature::make(1, 1, sizeof(gr_complex)),
 		gr::io_signature::make(1, 1, sizeof(gr_complex))),
 		blocks::control_loop(loop_bw, 1.0, -1.0),
-		d_order(order), d_error(0), d_noise(1.0), d_phase_detector(NULL)
+		d_order(order), d_error(0), d_noise(1.0), d_phase_detector(NULL), d_update_decim(1),
+		d_msgInputs(1), d_msgOutputs(1), d_burstMode(false), d_burstNThreads(1), d_burstThreads(1)
 {
 	d_genSignalPDUs = genPDUs;
 
@@ -80,10 +85,17 @@ costas2_impl::costas2_impl(float loop_bw, int order, bool genPDUs)
           boost::bind(&costas2_impl::handle_set_noise,
                       this, _1));
 	 */
-	message_port_register_in(pmt::mp("msgin"));
-	set_msg_handler(pmt::mp("msgin"), [this](pmt::pmt_t msg) { this->handleMsgIn(msg); });
+	d_msgInPort = pmt::mp("msgin");
+	message_port_register_in(d_msgInPort);
+	set_msg_handler(d_msgInPort, [this](pmt::pmt_t msg) { this->handleMsgIn(msg); });
 
-	message_port_register_out(pmt::mp("msgout"));
+	// Each PDU is one parallelFor item
+	d_burstThreads.setChunkSize(1);
+
+	d_phaseEstKey = pmt::intern("phase_est");
+	d_pduPort = pmt::mp("msgout");
+	d_emptyMeta = pmt::make_dict();
+	message_port_register_out(d_pduPort);
 }
 
 /*
@@ -108,6 +120,59 @@ costas2_impl::handle_set_noise(pmt::pmt_t msg)
 	}
 }
 
+void
+costas2_impl::set_update_decimation(int decim)
+{
+	if (decim < 1)
+		throw std::invalid_argument("costas2: update decimation must be at least 1.");
+
+	d_update_decim = decim;
+}
+
+int
+costas2_impl::update_decimation() const
+{
+	return d_update_decim;
+}
+
+void
+costas2_impl::work_decimated(int noutput_items, const gr_complex *iptr, gr_complex *optr, int decim)
+{
+	for (int start = 0; start < noutput_items; start += decim) {
+		int blockLen = std::min(decim, noutput_items - start);
+
+		if ((d_phase > CL_TWO_PI) || (d_phase < CL_MINUS_TWO_PI)) {
+			d_phase = d_phase * CL_ONE_OVER_2PI - (float)((int)(d_phase * CL_ONE_OVER_2PI));
+			d_phase = d_phase * CL_TWO_PI;
+		}
+
+		// With the frequency held for the block, the NCO is just a phase ramp
+		ncoRotateN(&optr[start], &iptr[start], -d_phase, -d_freq, blockLen, LFAST_NCO_ACCURATE);
+
+		// 2nd order detector, clipped per sample as in the per-sample loop, then averaged
+		const float *f = (const float *)&optr[start];
+		float errSum = 0.0f;
+
+		for (int k = 0; k < blockLen; k++) {
+			float e = f[2*k] * f[2*k+1];
+			errSum += 0.5f * (std::abs(e+1.0f) - std::abs(e-1.0f));
+		}
+
+		float m = (float)blockLen;
+		d_error = errSum / m;
+
+		// Jump straight to the state the per-sample loop reaches after m samples of a constant d_error:
+		// freq += m*beta*err, phase += m*(freq + alpha*err) + beta*err*m*(m+1)/2
+		d_phase += m * d_freq + (m * d_alpha + 0.5f * m * (m + 1.0f) * d_beta) * d_error;
+		d_freq += m * d_beta * d_error;
+
+		if(d_freq > d_max_freq)
+			d_freq = d_max_freq;
+		else if(d_freq < d_min_freq)
+			d_freq = d_min_freq;
+	}
+}
+
 int
 costas2_impl::work_original(int noutput_items,
 		gr_vector_const_void_star &input_items,
@@ -177,28 +242,162 @@ costas2_impl::work_original(int noutput_items,
 	return noutput_items;
 }
 
+void
+costas2_impl::set_burst_mode(bool burst_mode)
+{
+	gr::thread::scoped_lock l(d_setlock);
+	d_burstMode = burst_mode;
+}
+
+void
+costas2_impl::set_burst_threads(int nthreads)
+{
+	gr::thread::scoped_lock l(d_setlock);
+	d_burstThreads.setThreads(nthreads);
+	d_burstNThreads = d_burstThreads.numThreads();
+}
+
+static float
+burstSeed(pmt::pmt_t meta, pmt::pmt_t key)
+{
+	if (!pmt::is_dict(meta))
+		return 0.0f;
+
+	pmt::pmt_t value = pmt::dict_ref(meta, key, pmt::PMT_NIL);
+
+	return pmt::is_number(value) ? (float)pmt::to_double(value) : 0.0f;
+}
+
+void
+costas2_impl::burstLoop(const gr_complex *input, gr_complex *output, size_t numSamples, float phase, float freq) const
+{
+	const SComplex *iptr = (const SComplex *)input;
+	SComplex *optr = (SComplex *)output;
+	float n_r,n_i,o_r,o_i,err;
+
+	for(size_t i = 0; i < numSamples; i++) {
+		if ((phase > CL_TWO_PI) || (phase < CL_MINUS_TWO_PI)) {
+			phase = phase * CL_ONE_OVER_2PI - (float)((int)(phase * CL_ONE_OVER_2PI));
+			phase = phase * CL_TWO_PI;
+		}
+		n_i = sinf(-phase);
+		n_r = cosf(-phase);
+
+#if defined(__FMA__)
+		o_r = __builtin_fmaf(iptr[i].real,n_r,-iptr[i].imag*n_i);
+		o_i = __builtin_fmaf(iptr[i].real,n_i,iptr[i].imag*n_r);
+#else
+		o_r = (iptr[i].real * n_r) - (iptr[i].imag * n_i);
+		o_i = (iptr[i].real * n_i) + (iptr[i].imag * n_r);
+#endif
+		optr[i].real = o_r;
+		optr[i].imag = o_i;
+
+		err = o_r * o_i;
+		err = 0.5f * (std::abs(err+1.0f) - std::abs(err-1.0f));
+
+#if defined(__FMA__)
+		freq = __builtin_fmaf(d_beta,err,freq);
+		phase = phase + __builtin_fmaf(d_alpha,err,freq);
+#else
+		freq = d_beta * err + freq;
+		phase = phase + d_alpha * err + freq;
+#endif
+
+		if(freq > d_max_freq)
+			freq = d_max_freq;
+		else if(freq < d_min_freq)
+			freq = d_min_freq;
+	}
+}
+
+void
+costas2_impl::handleBursts(pmt::pmt_t msg)
+{
+	gr::thread::scoped_lock l(d_setlock);
+
+	// Take whatever else is already waiting on msgin (up to what the PDU pool holds),
+	// so a backlog gets spread over the threads.  An idle queue is just a batch of 1.
+	d_burstMsgs.clear();
+	d_burstMsgs.push_back(msg);
+
+	while ((d_burstMsgs.size() < LFAST_PDU_POOL_SIZE) && (nmsgs(d_msgInPort) > 0))
+		d_burstMsgs.push_back(delete_head_nowait(d_msgInPort));
+
+	size_t numBursts = d_burstMsgs.size();
+	d_bursts.resize(numBursts);
+
+	// Pool and pmt calls stay on this thread, the workers only run the loop
+	for (size_t i=0;i<numBursts;i++) {
+		BurstJob &job = d_bursts[i];
+		pmt::pmt_t meta = pmt::car(d_burstMsgs[i]);
+
+		job.input = pmt::c32vector_elements(pmt::cdr(d_burstMsgs[i]),job.numSamples);
+		job.phase = burstSeed(meta,d_phaseEstKey);
+		job.freq = burstSeed(meta,pmt::mp("freq_est"));
+		job.pdu = d_msgPool.getPDU(meta,job.numSamples,job.output);
+	}
+
+	d_burstThreads.parallelFor(numBursts, [this](long startIndex, long numItems, int threadIndex) {
+		for (long i=startIndex;i<startIndex+numItems;i++) {
+			const BurstJob &job = d_bursts[i];
+			burstLoop(job.input,job.output,job.numSamples,job.phase,job.freq);
+		}
+	});
+
+	for (size_t i=0;i<numBursts;i++) {
+		message_port_pub(d_pduPort,d_bursts[i].pdu);
+		// Drop our references so the pool can hand the PDU out again once downstream is done with it
+		d_bursts[i].pdu = pmt::PMT_NIL;
+	}
+
+	d_burstMsgs.clear();
+}
+
 void costas2_impl::handleMsgIn(pmt::pmt_t msg) {
 	if (!d_genSignalPDUs)
 		return;
 
+	if (d_burstMode) {
+		handleBursts(msg);
+		return;
+	}
+
 	pmt::pmt_t inputMetadata = pmt::car(msg);
 	pmt::pmt_t data = pmt::cdr(msg);
 	size_t noutput_items = pmt::length(data);
 	const gr_complex *cc_samples;
+	gr_complex *out;
 
 	cc_samples = pmt::c32vector_elements(data,noutput_items);
 
-	gr_complex out[noutput_items];
-	std::vector<const void *> items_in;
-	std::vector<void *> items_out;
-	items_out.push_back(&out[0]);
-	items_in.push_back(&cc_samples[0]);
+	// The loop writes straight into a pooled PDU that carries the input metadata through,
+	// so there's no copy and (for repeated burst sizes) no allocation.
+	pmt::pmt_t pdu = d_msgPool.getPDU(inputMetadata,noutput_items,out);
+
+	d_msgInputs[0] = cc_samples;
+	d_msgOutputs[0] = out;
+
+	work_test(noutput_items,d_msgInputs,d_msgOutputs);
 
-	int retVal = work_test(noutput_items,items_in,items_out);
+	message_port_pub(d_pduPort,pdu);
+}
+
+pmt::pmt_t
+costas2_impl::streamMetadata(int noutput_items)
+{
+	// Stream tags in the window become the PDU metadata.  Untagged windows share one empty dict.
+	get_tags_in_range(d_tags, 0, nitems_read(0), nitems_read(0)+noutput_items);
+
+	if (d_tags.empty())
+		return d_emptyMeta;
+
+	pmt::pmt_t meta = pmt::make_dict();
+
+	for (size_t i=0;i<d_tags.size();i++)
+		meta = pmt::dict_add(meta, d_tags[i].key, d_tags[i].value);
 
-	pmt::pmt_t data_out(pmt::init_c32vector(noutput_items, &out[0]));
-	pmt::pmt_t pdu = pmt::cons( inputMetadata, data_out );
-	message_port_pub(pmt::mp("msgout"),pdu);
+	return meta;
 }
 
 int
@@ -353,127 +552,160 @@ costas2_impl::work(int noutput_items,
 
 	// gr_complex nco_out;
 
-	for(i = 0; i < noutput_items; i++) {
-		// nco_out = gr_expj(-d_phase);
-		// returns this:  nco_out.real = n_r, nco_out.imag = n_i
-		// Trig functions killing performance.  Tried a number of replacement options but no luck:
-		// gnuradio lookup functions - expensive with float_to_fixed in each iteration
-		// Tried rolling our own lookup tables - Same performance as straight trig
-		// Tried quadratic curve inline approximation - Tiny bit faster
+	int decim = d_update_decim;
+	int segStart, segEnd;
+	size_t nextTag = 0;
 
-		if ((d_phase > CL_TWO_PI) || (d_phase < CL_MINUS_TWO_PI)) {
-			// d_phase = d_phase / CL_TWO_PI - (float)((int)(d_phase / CL_TWO_PI));
-			// switch to multiplication for faster op
+	get_tags_in_range(d_phaseTags, 0, nitems_read(0), nitems_read(0)+noutput_items, d_phaseEstKey);
+
+	if (d_phaseTags.size() > 1)
+		std::sort(d_phaseTags.begin(), d_phaseTags.end(), tag_t::offset_compare);
+
+	// phase_est tags set d_phase at their sample, so the call runs as tag-delimited segments
+	// through the unchanged inner loop.  Untagged calls are a single segment.
+	for (segStart = 0; segStart < noutput_items; segStart = segEnd) {
+		segEnd = noutput_items;
+
+		while (nextTag < d_phaseTags.size()) {
+			int tagIndex = (int)(d_phaseTags[nextTag].offset - nitems_read(0));
+
+			if (tagIndex > segStart) {
+				segEnd = tagIndex;
+				break;
+			}
+
+			d_phase = (float)pmt::to_double(d_phaseTags[nextTag].value);
+			nextTag++;
+		}
+
+		if (decim > 1) {
+			work_decimated(segEnd - segStart, (const gr_complex *)&iptr[segStart], (gr_complex *)&optr[segStart], decim);
+		}
+		else {
+			for(i = segStart; i < segEnd; i++) {
+				// nco_out = gr_expj(-d_phase);
+				// returns this:  nco_out.real = n_r, nco_out.imag = n_i
+				// Trig functions killing performance.  Tried a number of replacement options but no luck:
+				// gnuradio lookup functions - expensive with float_to_fixed in each iteration
+				// Tried rolling our own lookup tables - Same performance as straight trig
+				// Tried quadratic curve inline approximation - Tiny bit faster
+
+				if ((d_phase > CL_TWO_PI) || (d_phase < CL_MINUS_TWO_PI)) {
+					// d_phase = d_phase / CL_TWO_PI - (float)((int)(d_phase / CL_TWO_PI));
+					// switch to multiplication for faster op
 #if defined(__FMA__)
-			d_phase = __builtin_fmaf(d_phase,CL_ONE_OVER_2PI,-(float)((int)(d_phase * CL_ONE_OVER_2PI)));
+					d_phase = __builtin_fmaf(d_phase,CL_ONE_OVER_2PI,-(float)((int)(d_phase * CL_ONE_OVER_2PI)));
 #else
-			d_phase = d_phase * CL_ONE_OVER_2PI - (float)((int)(d_phase * CL_ONE_OVER_2PI));
+					d_phase = d_phase * CL_ONE_OVER_2PI - (float)((int)(d_phase * CL_ONE_OVER_2PI));
 #endif
-			d_phase = d_phase * CL_TWO_PI;
-		}
-		// gr::sincosf(-d_phase, &n_i, &n_r);
-		n_i = sinf(-d_phase);
-		n_r = cosf(-d_phase);
-		/*
-			 // Doesn't produce decodable results, AND it's slower.
+					d_phase = d_phase * CL_TWO_PI;
+				}
+				// gr::sincosf(-d_phase, &n_i, &n_r);
+				n_i = sinf(-d_phase);
+				n_r = cosf(-d_phase);
+				/*
+					 // Doesn't produce decodable results, AND it's slower.
 #if defined(__FMA__)
-			n_r = sqrtf(__builtin_fmaf(n_i,-n_i,1));
+					n_r = sqrtf(__builtin_fmaf(n_i,-n_i,1));
 #else
-			n_r = sqrtf(1-n_i*n_i);
+					n_r = sqrtf(1-n_i*n_i);
 #endif
-		 */
-		//optr[i] = iptr[i] * nco_out;
+				 */
+				//optr[i] = iptr[i] * nco_out;
 
-		// FMA stands for fused multiply-add operations where FMA(a,b,c)=(a*b)+c and it does it as a single operation.
+				// FMA stands for fused multiply-add operations where FMA(a,b,c)=(a*b)+c and it does it as a single operation.
 #if defined(__FMA__)
-		o_r = __builtin_fmaf(iptr[i].real,n_r,-iptr[i].imag*n_i);
-		o_i = __builtin_fmaf(iptr[i].real,n_i,iptr[i].imag*n_r);
+				o_r = __builtin_fmaf(iptr[i].real,n_r,-iptr[i].imag*n_i);
+				o_i = __builtin_fmaf(iptr[i].real,n_i,iptr[i].imag*n_r);
 #else
-		i_r = iptr[i].real;
-		i_i = iptr[i].imag;
-		o_r = (i_r * n_r) - (i_i*n_i);
-		o_i = (i_r * n_i) + (i_i * n_r);
+				i_r = iptr[i].real;
+				i_i = iptr[i].imag;
+				o_r = (i_r * n_r) - (i_i*n_i);
+				o_i = (i_r * n_i) + (i_i * n_r);
 #endif
 
-		optr[i].real = o_r;
-		optr[i].imag = o_i;
+				optr[i].real = o_r;
+				optr[i].imag = o_i;
 
-		//d_error = (*this.*d_phase_detector)(optr[i]);
-		// 2nd order in-place
-		d_error = o_r*o_i;
+				//d_error = (*this.*d_phase_detector)(optr[i]);
+				// 2nd order in-place
+				d_error = o_r*o_i;
 
-		// d_error = gr::branchless_clip(d_error, 1.0);
-		/*  Taken out for speed and consolidated
-          x1 = fabsf(d_error+1);
-          x2 = fabsf(d_error-1);
-          x1 -= x2;
-          d_error = 0.5*x1;
-		 */
+				// d_error = gr::branchless_clip(d_error, 1.0);
+				/*  Taken out for speed and consolidated
+		          x1 = fabsf(d_error+1);
+		          x2 = fabsf(d_error-1);
+		          x1 -= x2;
+		          d_error = 0.5*x1;
+				 */
 
-		// d_error = 0.5 * (fabsf(d_error+1) - fabsf(d_error-1));
+				// d_error = 0.5 * (fabsf(d_error+1) - fabsf(d_error-1));
 
-		// See http://stackoverflow.com/questions/23474796/is-there-a-fast-fabsf-replacement-for-float-in-c
-		// for some notes on fabs performance
-		d_error = 0.5 * (std::abs(d_error+1) - std::abs(d_error-1));
+				// See http://stackoverflow.com/questions/23474796/is-there-a-fast-fabsf-replacement-for-float-in-c
+				// for some notes on fabs performance
+				d_error = 0.5 * (std::abs(d_error+1) - std::abs(d_error-1));
 
 
-		//advance_loop(d_error);
+				//advance_loop(d_error);
 #if defined(__FMA__)
-		d_freq = __builtin_fmaf(d_beta,d_error,d_freq);
+				d_freq = __builtin_fmaf(d_beta,d_error,d_freq);
 #else
-		d_freq = d_beta * d_error + d_freq;
+				d_freq = d_beta * d_error + d_freq;
 #endif
-		//d_freq = __builtin_fmaf(d_beta,d_error,d_freq);
-		// This line is causing one of the greatest performance drops!  100 Msps -> 33 Msps!
+				//d_freq = __builtin_fmaf(d_beta,d_error,d_freq);
+				// This line is causing one of the greatest performance drops!  100 Msps -> 33 Msps!
 #if defined(__FMA__)
-		d_phase = d_phase + __builtin_fmaf(d_alpha,d_error,d_freq);
+				d_phase = d_phase + __builtin_fmaf(d_alpha,d_error,d_freq);
 #else
-		d_phase = d_phase + d_alpha * d_error + d_freq;
+				d_phase = d_phase + d_alpha * d_error + d_freq;
 #endif
-		// d_phase = d_phase + d_freq + d_alpha * d_error;
-		// d_phase = d_phase + __builtin_fmaf(d_alpha,d_error,d_freq);
-
-		//phase_wrap();
-		// Moved to top of loop.
-
-		/*
-          if (d_phase > CL_TWO_PI) {
-  			while(d_phase>CL_TWO_PI) {
-  			  d_phase -= CL_TWO_PI;
-  			}
-          }
-          else if (d_phase < CL_MINUS_TWO_PI) {
-  			while(d_phase < CL_MINUS_TWO_PI) {
-  			  d_phase += CL_TWO_PI;
-  			}
-          }
-		 */
-		//frequency_limit();
-		if(d_freq > d_max_freq)
-			d_freq = d_max_freq;
-		else if(d_freq < d_min_freq)
-			d_freq = d_min_freq;
-
-		/*
-		 * original code
-		nco_out = gr_expj(-d_phase);
-		optr[i] = iptr[i] * nco_out;
-
-		d_error = (*this.*d_phase_detector)(optr[i]);
-		d_error = gr::branchless_clip(d_error, 1.0);
-
-		advance_loop(d_error);
-		phase_wrap();
-		frequency_limit();
-		 */
+				// d_phase = d_phase + d_freq + d_alpha * d_error;
+				// d_phase = d_phase + __builtin_fmaf(d_alpha,d_error,d_freq);
+
+				//phase_wrap();
+				// Moved to top of loop.
+
+				/*
+		          if (d_phase > CL_TWO_PI) {
+		  			while(d_phase>CL_TWO_PI) {
+		  			  d_phase -= CL_TWO_PI;
+		  			}
+		          }
+		          else if (d_phase < CL_MINUS_TWO_PI) {
+		  			while(d_phase < CL_MINUS_TWO_PI) {
+		  			  d_phase += CL_TWO_PI;
+		  			}
+		          }
+				 */
+				//frequency_limit();
+				if(d_freq > d_max_freq)
+					d_freq = d_max_freq;
+				else if(d_freq < d_min_freq)
+					d_freq = d_min_freq;
+
+				/*
+				 * original code
+				nco_out = gr_expj(-d_phase);
+				optr[i] = iptr[i] * nco_out;
+
+				d_error = (*this.*d_phase_detector)(optr[i]);
+				d_error = gr::branchless_clip(d_error, 1.0);
+
+				advance_loop(d_error);
+				phase_wrap();
+				frequency_limit();
+				 */
 
+			}
+		}
 	}
 
 	if (d_genSignalPDUs) {
-		pmt::pmt_t meta = pmt::make_dict();
-		pmt::pmt_t data_out(pmt::init_c32vector(noutput_items, (gr_complex *)optr));
-		pmt::pmt_t pdu = pmt::cons( meta, data_out );
-		message_port_pub(pmt::mp("msgout"),pdu);
+		gr_complex *pduSamples;
+		pmt::pmt_t pdu = d_streamPool.getPDU(streamMetadata(noutput_items),noutput_items,pduSamples);
+
+		memcpy((void *)pduSamples,optr,noutput_items*sizeof(gr_complex));
+		message_port_pub(d_pduPort,pdu);
 	}
 
 	return noutput_items;
@@ -22,6 +22,8 @@
 #define INCLUDED_LFAST_COSTAS2_IMPL_H
 
 #include <lfast/costas2.h>
+#include "pdu_pool_lfast.h"
+#include "fir_filter_lfast.h"
 
 namespace gr {
   namespace lfast {
@@ -43,12 +45,60 @@ namespace gr {
 
        float (costas2_impl::*d_phase_detector)(gr_complex sample) const;
 
+       // Loop updates once per this many samples (1 is the per-sample loop)
+       int d_update_decim;
+
+       void work_decimated(int noutput_items, const gr_complex *iptr, gr_complex *optr, int decim);
+
+       pmt::pmt_t d_phaseEstKey;
+       std::vector<tag_t> d_phaseTags;
+
+       // PDU output.  Separate pools for msgin and the stream so each is only touched by one caller.
+       pmt::pmt_t d_pduPort;
+       pmt::pmt_t d_emptyMeta;
+       PDUPool d_msgPool;
+       PDUPool d_streamPool;
+       gr_vector_const_void_star d_msgInputs;
+       gr_vector_void_star d_msgOutputs;
+       std::vector<tag_t> d_tags;
+
+       pmt::pmt_t streamMetadata(int noutput_items);
+
+       // Burst mode: one batch of queued PDUs, demodulated in parallel then published in order
+       struct BurstJob {
+    	   const gr_complex *input;
+    	   gr_complex *output;
+    	   size_t numSamples;
+    	   float phase;
+    	   float freq;
+    	   pmt::pmt_t pdu;
+       };
+
+       bool d_burstMode;
+       int d_burstNThreads;
+       pmt::pmt_t d_msgInPort;
+       MTBase d_burstThreads;
+       std::vector<pmt::pmt_t> d_burstMsgs;
+       std::vector<BurstJob> d_bursts;
+
+       void handleBursts(pmt::pmt_t msg);
+       // The work() loop on a private copy of the loop state
+       void burstLoop(const gr_complex *input, gr_complex *output, size_t numSamples, float phase, float freq) const;
+
      public:
       costas2_impl(float loop_bw, int order, bool genPDUs);
       ~costas2_impl();
 
       float error() const;
 
+      void set_update_decimation(int decim);
+      int update_decimation() const;
+
+      void set_burst_mode(bool burst_mode);
+      bool burst_mode() const { return d_burstMode; };
+      void set_burst_threads(int nthreads);
+      int burst_threads() const { return d_burstNThreads; };
+
       // void printSineError();
 
       void handle_set_noise(pmt::pmt_t msg);
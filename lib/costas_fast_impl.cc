@@ -0,0 +1,176 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include <gnuradio/io_signature.h>
+#include "costas_fast_impl.h"
+#include <gnuradio/expj.h>
+#include <gnuradio/math.h>
+#include "clSComplex.h"
+#include <stdexcept>
+
+#define CL_TWO_PI 6.28318530717958647692
+#define CL_ONE_OVER_2PI 0.15915494309189533577
+#define CL_MINUS_TWO_PI -6.28318530717958647692
+
+// assisted detection of Fused Multiply Add (FMA) functionality
+#if !defined(__FMA__) && defined(__AVX2__)
+#define __FMA__ 1
+#endif
+
+#if defined(FP_FAST_FMA)
+#define __FMA__ 1
+#endif
+
+namespace gr {
+namespace lfast {
+
+costas_fast::sptr costas_fast::make(float loop_bw, int order)
+{
+	switch (order) {
+	case 2:
+		return gnuradio::make_block_sptr<costas_fast_impl<2> >(loop_bw);
+	case 4:
+		return gnuradio::make_block_sptr<costas_fast_impl<4> >(loop_bw);
+	case 8:
+		return gnuradio::make_block_sptr<costas_fast_impl<8> >(loop_bw);
+	default:
+		throw std::invalid_argument("costas_fast: order must be 2, 4, or 8.");
+	}
+}
+
+/*
+ * The private constructor
+ */
+template <int ORDER>
+costas_fast_impl<ORDER>::costas_fast_impl(float loop_bw)
+: gr::sync_block("costas_fast",
+		gr::io_signature::make(1, 1, sizeof(gr_complex)),
+		gr::io_signature::make(1, 1, sizeof(gr_complex))),
+		blocks::control_loop(loop_bw, 1.0, -1.0),
+		d_error(0)
+{
+}
+
+/*
+ * Our virtual destructor.
+ */
+template <int ORDER>
+costas_fast_impl<ORDER>::~costas_fast_impl()
+{
+}
+
+template <int ORDER>
+float
+costas_fast_impl<ORDER>::error() const
+{
+	return d_error;
+}
+
+template <int ORDER>
+int
+costas_fast_impl<ORDER>::work_original(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	const gr_complex *iptr = (gr_complex *) input_items[0];
+	gr_complex *optr = (gr_complex *) output_items[0];
+	gr_complex nco_out;
+
+	for(int i = 0; i < noutput_items; i++) {
+		nco_out = gr_expj(-d_phase);
+		optr[i] = iptr[i] * nco_out;
+
+		d_error = costasDetector<ORDER>(optr[i].real(), optr[i].imag());
+		d_error = gr::branchless_clip(d_error, 1.0);
+
+		advance_loop(d_error);
+		phase_wrap();
+		frequency_limit();
+	}
+
+	return noutput_items;
+}
+
+template <int ORDER>
+int
+costas_fast_impl<ORDER>::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	const SComplex *iptr = (SComplex *) input_items[0];
+	SComplex *optr = (SComplex *) output_items[0];
+	float n_r,n_i,o_r,o_i;
+#if !defined(__FMA__)
+	float i_r,i_i;
+#endif
+
+	for(int i = 0; i < noutput_items; i++) {
+		if ((d_phase > CL_TWO_PI) || (d_phase < CL_MINUS_TWO_PI)) {
+#if defined(__FMA__)
+			d_phase = __builtin_fmaf(d_phase,CL_ONE_OVER_2PI,-(float)((int)(d_phase * CL_ONE_OVER_2PI)));
+#else
+			d_phase = d_phase * CL_ONE_OVER_2PI - (float)((int)(d_phase * CL_ONE_OVER_2PI));
+#endif
+			d_phase = d_phase * CL_TWO_PI;
+		}
+		n_i = sinf(-d_phase);
+		n_r = cosf(-d_phase);
+
+#if defined(__FMA__)
+		o_r = __builtin_fmaf(iptr[i].real,n_r,-iptr[i].imag*n_i);
+		o_i = __builtin_fmaf(iptr[i].real,n_i,iptr[i].imag*n_r);
+#else
+		i_r = iptr[i].real;
+		i_i = iptr[i].imag;
+		o_r = (i_r * n_r) - (i_i*n_i);
+		o_i = (i_r * n_i) + (i_i * n_r);
+#endif
+		optr[i].real = o_r;
+		optr[i].imag = o_i;
+
+		// Inlined detector for this order, then branchless clip to +/-1
+		d_error = costasDetector<ORDER>(o_r, o_i);
+		d_error = 0.5 * (std::abs(d_error+1) - std::abs(d_error-1));
+
+#if defined(__FMA__)
+		d_freq = __builtin_fmaf(d_beta,d_error,d_freq);
+		d_phase = d_phase + __builtin_fmaf(d_alpha,d_error,d_freq);
+#else
+		d_freq = d_beta * d_error + d_freq;
+		d_phase = d_phase + d_alpha * d_error + d_freq;
+#endif
+
+		if(d_freq > d_max_freq)
+			d_freq = d_max_freq;
+		else if(d_freq < d_min_freq)
+			d_freq = d_min_freq;
+	}
+
+	return noutput_items;
+}
+
+template class costas_fast_impl<2>;
+template class costas_fast_impl<4>;
+template class costas_fast_impl<8>;
+
+} /* namespace lfast */
+} /* namespace gr */
+
@@ -0,0 +1,82 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_LFAST_COSTAS_FAST_IMPL_H
+#define INCLUDED_LFAST_COSTAS_FAST_IMPL_H
+
+#include <lfast/costas_fast.h>
+#include <cmath>
+
+namespace gr {
+  namespace lfast {
+
+    /*
+     * Costas phase detectors, one specialization per order so they inline into the loop.
+     * r and i are the derotated sample.  All are branch-free (the selects compile to blends/cmovs).
+     */
+    template <int ORDER> inline float costasDetector(float r, float i);
+
+    template <> inline float costasDetector<2>(float r, float i) {
+    	return r * i;
+    }
+
+    template <> inline float costasDetector<4>(float r, float i) {
+    	return (r>0 ? 1.0f : -1.0f) * i - (i>0 ? 1.0f : -1.0f) * r;
+    }
+
+    // Decision-directed 8PSK: the smaller of the two terms is scaled by tan(pi/8) = sqrt(2)-1
+    template <> inline float costasDetector<8>(float r, float i) {
+    	const float K = 0.41421356237309504880f;
+    	bool realLarger = std::abs(r) >= std::abs(i);
+    	float kImag = realLarger ? 1.0f : K;
+    	float kReal = realLarger ? K : 1.0f;
+
+    	return (r>0 ? 1.0f : -1.0f) * i * kImag - (i>0 ? 1.0f : -1.0f) * r * kReal;
+    }
+
+    template <int ORDER>
+    class costas_fast_impl : public costas_fast
+    {
+     private:
+       float d_error;
+
+     public:
+      costas_fast_impl(float loop_bw);
+      ~costas_fast_impl();
+
+      float error() const;
+      int order() const { return ORDER; };
+
+      // Where all the action really happens
+      int work(int noutput_items,
+         gr_vector_const_void_star &input_items,
+         gr_vector_void_star &output_items);
+      // Plain per-sample loop as in gr::digital::costas_loop_cc, for timing comparisons
+      int work_original(int noutput_items,
+         gr_vector_const_void_star &input_items,
+         gr_vector_void_star &output_items);
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_COSTAS_FAST_IMPL_H */
+
@@ -0,0 +1,794 @@
+/*
+ * fir_blocked_lfast.cc
+ *
+ *      Copyright 2019, Michael Piscopo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "fir_blocked_lfast.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LFAST_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace gr {
+  namespace lfast {
+
+#if defined(LFAST_X86_KERNELS)
+	// Each kernel keeps 4 output registers in flight.  Complex taps need a second set
+	// for the imaginary tap products, combined once at the end of the block.
+
+	// ---------------------------------------------------------
+	// SSE (no FMA)
+	// ---------------------------------------------------------
+	__attribute__((target("sse2")))
+	static long filterCCF_sse(gr_complex *outputBuffer, const gr_complex *inputBuffer, const float *taps, long numTaps, long numOutputs) {
+		const long block = 8;	// 4 registers x 2 complex outputs
+		long blockedOutputs = (numOutputs / block) * block;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m128 acc0 = _mm_setzero_ps();
+			__m128 acc1 = _mm_setzero_ps();
+			__m128 acc2 = _mm_setzero_ps();
+			__m128 acc3 = _mm_setzero_ps();
+			const float *in = (const float *)&inputBuffer[i];
+
+			for (long k=0;k<numTaps;k++) {
+				__m128 tap = _mm_set1_ps(taps[k]);
+
+				acc0 = _mm_add_ps(acc0,_mm_mul_ps(_mm_loadu_ps(in),tap));
+				acc1 = _mm_add_ps(acc1,_mm_mul_ps(_mm_loadu_ps(in+4),tap));
+				acc2 = _mm_add_ps(acc2,_mm_mul_ps(_mm_loadu_ps(in+8),tap));
+				acc3 = _mm_add_ps(acc3,_mm_mul_ps(_mm_loadu_ps(in+12),tap));
+				in += 2;
+			}
+
+			float *out = (float *)&outputBuffer[i];
+			_mm_storeu_ps(out,acc0);
+			_mm_storeu_ps(out+4,acc1);
+			_mm_storeu_ps(out+8,acc2);
+			_mm_storeu_ps(out+12,acc3);
+		}
+
+		return blockedOutputs;
+	}
+
+	__attribute__((target("sse2")))
+	static long filterFFF_sse(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, long numOutputs) {
+		const long block = 16;	// 4 registers x 4 outputs
+		long blockedOutputs = (numOutputs / block) * block;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m128 acc0 = _mm_setzero_ps();
+			__m128 acc1 = _mm_setzero_ps();
+			__m128 acc2 = _mm_setzero_ps();
+			__m128 acc3 = _mm_setzero_ps();
+			const float *in = &inputBuffer[i];
+
+			for (long k=0;k<numTaps;k++) {
+				__m128 tap = _mm_set1_ps(taps[k]);
+
+				acc0 = _mm_add_ps(acc0,_mm_mul_ps(_mm_loadu_ps(in),tap));
+				acc1 = _mm_add_ps(acc1,_mm_mul_ps(_mm_loadu_ps(in+4),tap));
+				acc2 = _mm_add_ps(acc2,_mm_mul_ps(_mm_loadu_ps(in+8),tap));
+				acc3 = _mm_add_ps(acc3,_mm_mul_ps(_mm_loadu_ps(in+12),tap));
+				in++;
+			}
+
+			float *out = &outputBuffer[i];
+			_mm_storeu_ps(out,acc0);
+			_mm_storeu_ps(out+4,acc1);
+			_mm_storeu_ps(out+8,acc2);
+			_mm_storeu_ps(out+12,acc3);
+		}
+
+		return blockedOutputs;
+	}
+
+	__attribute__((target("sse2")))
+	static long filterCCC_sse(gr_complex *outputBuffer, const gr_complex *inputBuffer, const gr_complex *taps, long numTaps, long numOutputs) {
+		const long block = 8;	// 4 registers x 2 complex outputs
+		long blockedOutputs = (numOutputs / block) * block;
+		const float *tapValues = (const float *)taps;
+		// (re,im) * (tr,ti) = (re*tr - im*ti, im*tr + re*ti): the swapped products get this sign
+		const __m128 signs = _mm_setr_ps(-1.0f,1.0f,-1.0f,1.0f);
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m128 accR0 = _mm_setzero_ps();
+			__m128 accR1 = _mm_setzero_ps();
+			__m128 accR2 = _mm_setzero_ps();
+			__m128 accR3 = _mm_setzero_ps();
+			__m128 accI0 = _mm_setzero_ps();
+			__m128 accI1 = _mm_setzero_ps();
+			__m128 accI2 = _mm_setzero_ps();
+			__m128 accI3 = _mm_setzero_ps();
+			const float *in = (const float *)&inputBuffer[i];
+
+			for (long k=0;k<numTaps;k++) {
+				__m128 tapR = _mm_set1_ps(tapValues[2*k]);
+				__m128 tapI = _mm_set1_ps(tapValues[2*k+1]);
+				__m128 x0 = _mm_loadu_ps(in);
+				__m128 x1 = _mm_loadu_ps(in+4);
+				__m128 x2 = _mm_loadu_ps(in+8);
+				__m128 x3 = _mm_loadu_ps(in+12);
+
+				accR0 = _mm_add_ps(accR0,_mm_mul_ps(x0,tapR));
+				accR1 = _mm_add_ps(accR1,_mm_mul_ps(x1,tapR));
+				accR2 = _mm_add_ps(accR2,_mm_mul_ps(x2,tapR));
+				accR3 = _mm_add_ps(accR3,_mm_mul_ps(x3,tapR));
+				accI0 = _mm_add_ps(accI0,_mm_mul_ps(_mm_shuffle_ps(x0,x0,0xB1),tapI));
+				accI1 = _mm_add_ps(accI1,_mm_mul_ps(_mm_shuffle_ps(x1,x1,0xB1),tapI));
+				accI2 = _mm_add_ps(accI2,_mm_mul_ps(_mm_shuffle_ps(x2,x2,0xB1),tapI));
+				accI3 = _mm_add_ps(accI3,_mm_mul_ps(_mm_shuffle_ps(x3,x3,0xB1),tapI));
+				in += 2;
+			}
+
+			float *out = (float *)&outputBuffer[i];
+			_mm_storeu_ps(out,_mm_add_ps(accR0,_mm_mul_ps(accI0,signs)));
+			_mm_storeu_ps(out+4,_mm_add_ps(accR1,_mm_mul_ps(accI1,signs)));
+			_mm_storeu_ps(out+8,_mm_add_ps(accR2,_mm_mul_ps(accI2,signs)));
+			_mm_storeu_ps(out+12,_mm_add_ps(accR3,_mm_mul_ps(accI3,signs)));
+		}
+
+		return blockedOutputs;
+	}
+
+	// Folded kernels for symmetric / antisymmetric taps.  Both data types are run as floats:
+	// stride is 1 for float input and 2 for interleaved complex input with real taps.
+	__attribute__((target("sse2")))
+	static long filterFolded_sse(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, bool antisymmetric,
+			long numOutputs, long stride) {
+		const long block = 16 / stride;	// 4 registers of outputs
+		long blockedOutputs = (numOutputs / block) * block;
+		long halfTaps = numTaps / 2;
+		// Distance between mirrored samples, in floats
+		long mirror = (numTaps - 1) * stride;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m128 acc0 = _mm_setzero_ps();
+			__m128 acc1 = _mm_setzero_ps();
+			__m128 acc2 = _mm_setzero_ps();
+			__m128 acc3 = _mm_setzero_ps();
+			const float *in = &inputBuffer[i*stride];
+
+			for (long k=0;k<halfTaps;k++) {
+				__m128 tap = _mm_set1_ps(taps[k]);
+				const float *inMirror = in + mirror - 2*k*stride;
+				__m128 x0,x1,x2,x3;
+
+				if (antisymmetric) {
+					x0 = _mm_sub_ps(_mm_loadu_ps(in),_mm_loadu_ps(inMirror));
+					x1 = _mm_sub_ps(_mm_loadu_ps(in+4),_mm_loadu_ps(inMirror+4));
+					x2 = _mm_sub_ps(_mm_loadu_ps(in+8),_mm_loadu_ps(inMirror+8));
+					x3 = _mm_sub_ps(_mm_loadu_ps(in+12),_mm_loadu_ps(inMirror+12));
+				}
+				else {
+					x0 = _mm_add_ps(_mm_loadu_ps(in),_mm_loadu_ps(inMirror));
+					x1 = _mm_add_ps(_mm_loadu_ps(in+4),_mm_loadu_ps(inMirror+4));
+					x2 = _mm_add_ps(_mm_loadu_ps(in+8),_mm_loadu_ps(inMirror+8));
+					x3 = _mm_add_ps(_mm_loadu_ps(in+12),_mm_loadu_ps(inMirror+12));
+				}
+
+				acc0 = _mm_add_ps(acc0,_mm_mul_ps(x0,tap));
+				acc1 = _mm_add_ps(acc1,_mm_mul_ps(x1,tap));
+				acc2 = _mm_add_ps(acc2,_mm_mul_ps(x2,tap));
+				acc3 = _mm_add_ps(acc3,_mm_mul_ps(x3,tap));
+				in += stride;
+			}
+
+			// Odd length: the center tap has no mirror (and is 0 for antisymmetric taps)
+			if ((numTaps & 1) && !antisymmetric) {
+				__m128 tap = _mm_set1_ps(taps[halfTaps]);
+				__m128 x0 = _mm_loadu_ps(in);
+				__m128 x1 = _mm_loadu_ps(in+4);
+				__m128 x2 = _mm_loadu_ps(in+8);
+				__m128 x3 = _mm_loadu_ps(in+12);
+
+				acc0 = _mm_add_ps(acc0,_mm_mul_ps(x0,tap));
+				acc1 = _mm_add_ps(acc1,_mm_mul_ps(x1,tap));
+				acc2 = _mm_add_ps(acc2,_mm_mul_ps(x2,tap));
+				acc3 = _mm_add_ps(acc3,_mm_mul_ps(x3,tap));
+			}
+
+			float *out = &outputBuffer[i*stride];
+			_mm_storeu_ps(out,acc0);
+			_mm_storeu_ps(out+4,acc1);
+			_mm_storeu_ps(out+8,acc2);
+			_mm_storeu_ps(out+12,acc3);
+		}
+
+		return blockedOutputs;
+	}
+
+	__attribute__((target("sse2")))
+	static long accumulateS16_sse(int32_t *accI, int32_t *accQ, const int32_t *pairsI, const int32_t *pairsQ,
+			const int32_t *tapPairs, long numTapPairs, long numOutputs) {
+		const long block = 8;	// 2 registers x 4 outputs per plane
+		long blockedOutputs = (numOutputs / block) * block;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m128i sumI0 = _mm_loadu_si128((const __m128i *)&accI[i]);
+			__m128i sumI1 = _mm_loadu_si128((const __m128i *)&accI[i+4]);
+			__m128i sumQ0 = _mm_loadu_si128((const __m128i *)&accQ[i]);
+			__m128i sumQ1 = _mm_loadu_si128((const __m128i *)&accQ[i+4]);
+			const int32_t *inI = &pairsI[i];
+			const int32_t *inQ = &pairsQ[i];
+
+			for (long j=0;j<numTapPairs;j++) {
+				__m128i tap = _mm_set1_epi32(tapPairs[j]);
+
+				sumI0 = _mm_add_epi32(sumI0,_mm_madd_epi16(_mm_loadu_si128((const __m128i *)inI),tap));
+				sumI1 = _mm_add_epi32(sumI1,_mm_madd_epi16(_mm_loadu_si128((const __m128i *)(inI+4)),tap));
+				sumQ0 = _mm_add_epi32(sumQ0,_mm_madd_epi16(_mm_loadu_si128((const __m128i *)inQ),tap));
+				sumQ1 = _mm_add_epi32(sumQ1,_mm_madd_epi16(_mm_loadu_si128((const __m128i *)(inQ+4)),tap));
+				inI += 2;
+				inQ += 2;
+			}
+
+			_mm_storeu_si128((__m128i *)&accI[i],sumI0);
+			_mm_storeu_si128((__m128i *)&accI[i+4],sumI1);
+			_mm_storeu_si128((__m128i *)&accQ[i],sumQ0);
+			_mm_storeu_si128((__m128i *)&accQ[i+4],sumQ1);
+		}
+
+		return blockedOutputs;
+	}
+
+	// ---------------------------------------------------------
+	// AVX2 + FMA
+	// ---------------------------------------------------------
+	__attribute__((target("avx2,fma")))
+	static long filterCCF_avx2(gr_complex *outputBuffer, const gr_complex *inputBuffer, const float *taps, long numTaps, long numOutputs) {
+		const long block = 16;	// 4 registers x 4 complex outputs
+		long blockedOutputs = (numOutputs / block) * block;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m256 acc0 = _mm256_setzero_ps();
+			__m256 acc1 = _mm256_setzero_ps();
+			__m256 acc2 = _mm256_setzero_ps();
+			__m256 acc3 = _mm256_setzero_ps();
+			const float *in = (const float *)&inputBuffer[i];
+
+			for (long k=0;k<numTaps;k++) {
+				__m256 tap = _mm256_set1_ps(taps[k]);
+
+				acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(in),tap,acc0);
+				acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(in+8),tap,acc1);
+				acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(in+16),tap,acc2);
+				acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(in+24),tap,acc3);
+				in += 2;
+			}
+
+			float *out = (float *)&outputBuffer[i];
+			_mm256_storeu_ps(out,acc0);
+			_mm256_storeu_ps(out+8,acc1);
+			_mm256_storeu_ps(out+16,acc2);
+			_mm256_storeu_ps(out+24,acc3);
+		}
+
+		return blockedOutputs;
+	}
+
+	__attribute__((target("avx2,fma")))
+	static long filterFFF_avx2(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, long numOutputs) {
+		const long block = 32;	// 4 registers x 8 outputs
+		long blockedOutputs = (numOutputs / block) * block;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m256 acc0 = _mm256_setzero_ps();
+			__m256 acc1 = _mm256_setzero_ps();
+			__m256 acc2 = _mm256_setzero_ps();
+			__m256 acc3 = _mm256_setzero_ps();
+			const float *in = &inputBuffer[i];
+
+			for (long k=0;k<numTaps;k++) {
+				__m256 tap = _mm256_set1_ps(taps[k]);
+
+				acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(in),tap,acc0);
+				acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(in+8),tap,acc1);
+				acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(in+16),tap,acc2);
+				acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(in+24),tap,acc3);
+				in++;
+			}
+
+			float *out = &outputBuffer[i];
+			_mm256_storeu_ps(out,acc0);
+			_mm256_storeu_ps(out+8,acc1);
+			_mm256_storeu_ps(out+16,acc2);
+			_mm256_storeu_ps(out+24,acc3);
+		}
+
+		return blockedOutputs;
+	}
+
+	__attribute__((target("avx2,fma")))
+	static long filterCCC_avx2(gr_complex *outputBuffer, const gr_complex *inputBuffer, const gr_complex *taps, long numTaps, long numOutputs) {
+		const long block = 16;	// 4 registers x 4 complex outputs
+		long blockedOutputs = (numOutputs / block) * block;
+		const float *tapValues = (const float *)taps;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m256 accR0 = _mm256_setzero_ps();
+			__m256 accR1 = _mm256_setzero_ps();
+			__m256 accR2 = _mm256_setzero_ps();
+			__m256 accR3 = _mm256_setzero_ps();
+			__m256 accI0 = _mm256_setzero_ps();
+			__m256 accI1 = _mm256_setzero_ps();
+			__m256 accI2 = _mm256_setzero_ps();
+			__m256 accI3 = _mm256_setzero_ps();
+			const float *in = (const float *)&inputBuffer[i];
+
+			for (long k=0;k<numTaps;k++) {
+				__m256 tapR = _mm256_set1_ps(tapValues[2*k]);
+				__m256 tapI = _mm256_set1_ps(tapValues[2*k+1]);
+				__m256 x0 = _mm256_loadu_ps(in);
+				__m256 x1 = _mm256_loadu_ps(in+8);
+				__m256 x2 = _mm256_loadu_ps(in+16);
+				__m256 x3 = _mm256_loadu_ps(in+24);
+
+				accR0 = _mm256_fmadd_ps(x0,tapR,accR0);
+				accR1 = _mm256_fmadd_ps(x1,tapR,accR1);
+				accR2 = _mm256_fmadd_ps(x2,tapR,accR2);
+				accR3 = _mm256_fmadd_ps(x3,tapR,accR3);
+				accI0 = _mm256_fmadd_ps(_mm256_permute_ps(x0,0xB1),tapI,accI0);
+				accI1 = _mm256_fmadd_ps(_mm256_permute_ps(x1,0xB1),tapI,accI1);
+				accI2 = _mm256_fmadd_ps(_mm256_permute_ps(x2,0xB1),tapI,accI2);
+				accI3 = _mm256_fmadd_ps(_mm256_permute_ps(x3,0xB1),tapI,accI3);
+				in += 2;
+			}
+
+			// addsub gives (re*tr - im*ti, im*tr + re*ti)
+			float *out = (float *)&outputBuffer[i];
+			_mm256_storeu_ps(out,_mm256_addsub_ps(accR0,accI0));
+			_mm256_storeu_ps(out+8,_mm256_addsub_ps(accR1,accI1));
+			_mm256_storeu_ps(out+16,_mm256_addsub_ps(accR2,accI2));
+			_mm256_storeu_ps(out+24,_mm256_addsub_ps(accR3,accI3));
+		}
+
+		return blockedOutputs;
+	}
+
+	// Folded kernels for symmetric / antisymmetric taps.  Both data types are run as floats:
+	// stride is 1 for float input and 2 for interleaved complex input with real taps.
+	__attribute__((target("avx2,fma")))
+	static long filterFolded_avx2(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, bool antisymmetric,
+			long numOutputs, long stride) {
+		const long block = 32 / stride;	// 4 registers of outputs
+		long blockedOutputs = (numOutputs / block) * block;
+		long halfTaps = numTaps / 2;
+		// Distance between mirrored samples, in floats
+		long mirror = (numTaps - 1) * stride;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m256 acc0 = _mm256_setzero_ps();
+			__m256 acc1 = _mm256_setzero_ps();
+			__m256 acc2 = _mm256_setzero_ps();
+			__m256 acc3 = _mm256_setzero_ps();
+			const float *in = &inputBuffer[i*stride];
+
+			for (long k=0;k<halfTaps;k++) {
+				__m256 tap = _mm256_set1_ps(taps[k]);
+				const float *inMirror = in + mirror - 2*k*stride;
+				__m256 x0,x1,x2,x3;
+
+				if (antisymmetric) {
+					x0 = _mm256_sub_ps(_mm256_loadu_ps(in),_mm256_loadu_ps(inMirror));
+					x1 = _mm256_sub_ps(_mm256_loadu_ps(in+8),_mm256_loadu_ps(inMirror+8));
+					x2 = _mm256_sub_ps(_mm256_loadu_ps(in+16),_mm256_loadu_ps(inMirror+16));
+					x3 = _mm256_sub_ps(_mm256_loadu_ps(in+24),_mm256_loadu_ps(inMirror+24));
+				}
+				else {
+					x0 = _mm256_add_ps(_mm256_loadu_ps(in),_mm256_loadu_ps(inMirror));
+					x1 = _mm256_add_ps(_mm256_loadu_ps(in+8),_mm256_loadu_ps(inMirror+8));
+					x2 = _mm256_add_ps(_mm256_loadu_ps(in+16),_mm256_loadu_ps(inMirror+16));
+					x3 = _mm256_add_ps(_mm256_loadu_ps(in+24),_mm256_loadu_ps(inMirror+24));
+				}
+
+				acc0 = _mm256_fmadd_ps(x0,tap,acc0);
+				acc1 = _mm256_fmadd_ps(x1,tap,acc1);
+				acc2 = _mm256_fmadd_ps(x2,tap,acc2);
+				acc3 = _mm256_fmadd_ps(x3,tap,acc3);
+				in += stride;
+			}
+
+			// Odd length: the center tap has no mirror (and is 0 for antisymmetric taps)
+			if ((numTaps & 1) && !antisymmetric) {
+				__m256 tap = _mm256_set1_ps(taps[halfTaps]);
+				__m256 x0 = _mm256_loadu_ps(in);
+				__m256 x1 = _mm256_loadu_ps(in+8);
+				__m256 x2 = _mm256_loadu_ps(in+16);
+				__m256 x3 = _mm256_loadu_ps(in+24);
+
+				acc0 = _mm256_fmadd_ps(x0,tap,acc0);
+				acc1 = _mm256_fmadd_ps(x1,tap,acc1);
+				acc2 = _mm256_fmadd_ps(x2,tap,acc2);
+				acc3 = _mm256_fmadd_ps(x3,tap,acc3);
+			}
+
+			float *out = &outputBuffer[i*stride];
+			_mm256_storeu_ps(out,acc0);
+			_mm256_storeu_ps(out+8,acc1);
+			_mm256_storeu_ps(out+16,acc2);
+			_mm256_storeu_ps(out+24,acc3);
+		}
+
+		return blockedOutputs;
+	}
+
+	__attribute__((target("avx2")))
+	static long accumulateS16_avx2(int32_t *accI, int32_t *accQ, const int32_t *pairsI, const int32_t *pairsQ,
+			const int32_t *tapPairs, long numTapPairs, long numOutputs) {
+		const long block = 16;	// 2 registers x 8 outputs per plane
+		long blockedOutputs = (numOutputs / block) * block;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m256i sumI0 = _mm256_loadu_si256((const __m256i *)&accI[i]);
+			__m256i sumI1 = _mm256_loadu_si256((const __m256i *)&accI[i+8]);
+			__m256i sumQ0 = _mm256_loadu_si256((const __m256i *)&accQ[i]);
+			__m256i sumQ1 = _mm256_loadu_si256((const __m256i *)&accQ[i+8]);
+			const int32_t *inI = &pairsI[i];
+			const int32_t *inQ = &pairsQ[i];
+
+			for (long j=0;j<numTapPairs;j++) {
+				__m256i tap = _mm256_set1_epi32(tapPairs[j]);
+
+				sumI0 = _mm256_add_epi32(sumI0,_mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)inI),tap));
+				sumI1 = _mm256_add_epi32(sumI1,_mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(inI+8)),tap));
+				sumQ0 = _mm256_add_epi32(sumQ0,_mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)inQ),tap));
+				sumQ1 = _mm256_add_epi32(sumQ1,_mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(inQ+8)),tap));
+				inI += 2;
+				inQ += 2;
+			}
+
+			_mm256_storeu_si256((__m256i *)&accI[i],sumI0);
+			_mm256_storeu_si256((__m256i *)&accI[i+8],sumI1);
+			_mm256_storeu_si256((__m256i *)&accQ[i],sumQ0);
+			_mm256_storeu_si256((__m256i *)&accQ[i+8],sumQ1);
+		}
+
+		return blockedOutputs;
+	}
+
+	// ---------------------------------------------------------
+	// AVX-512
+	// ---------------------------------------------------------
+	__attribute__((target("avx512f")))
+	static long filterCCF_avx512(gr_complex *outputBuffer, const gr_complex *inputBuffer, const float *taps, long numTaps, long numOutputs) {
+		const long block = 32;	// 4 registers x 8 complex outputs
+		long blockedOutputs = (numOutputs / block) * block;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m512 acc0 = _mm512_setzero_ps();
+			__m512 acc1 = _mm512_setzero_ps();
+			__m512 acc2 = _mm512_setzero_ps();
+			__m512 acc3 = _mm512_setzero_ps();
+			const float *in = (const float *)&inputBuffer[i];
+
+			for (long k=0;k<numTaps;k++) {
+				__m512 tap = _mm512_set1_ps(taps[k]);
+
+				acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(in),tap,acc0);
+				acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(in+16),tap,acc1);
+				acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(in+32),tap,acc2);
+				acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(in+48),tap,acc3);
+				in += 2;
+			}
+
+			float *out = (float *)&outputBuffer[i];
+			_mm512_storeu_ps(out,acc0);
+			_mm512_storeu_ps(out+16,acc1);
+			_mm512_storeu_ps(out+32,acc2);
+			_mm512_storeu_ps(out+48,acc3);
+		}
+
+		return blockedOutputs;
+	}
+
+	__attribute__((target("avx512f")))
+	static long filterFFF_avx512(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, long numOutputs) {
+		const long block = 64;	// 4 registers x 16 outputs
+		long blockedOutputs = (numOutputs / block) * block;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m512 acc0 = _mm512_setzero_ps();
+			__m512 acc1 = _mm512_setzero_ps();
+			__m512 acc2 = _mm512_setzero_ps();
+			__m512 acc3 = _mm512_setzero_ps();
+			const float *in = &inputBuffer[i];
+
+			for (long k=0;k<numTaps;k++) {
+				__m512 tap = _mm512_set1_ps(taps[k]);
+
+				acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(in),tap,acc0);
+				acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(in+16),tap,acc1);
+				acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(in+32),tap,acc2);
+				acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(in+48),tap,acc3);
+				in++;
+			}
+
+			float *out = &outputBuffer[i];
+			_mm512_storeu_ps(out,acc0);
+			_mm512_storeu_ps(out+16,acc1);
+			_mm512_storeu_ps(out+32,acc2);
+			_mm512_storeu_ps(out+48,acc3);
+		}
+
+		return blockedOutputs;
+	}
+
+	__attribute__((target("avx512f")))
+	static long filterCCC_avx512(gr_complex *outputBuffer, const gr_complex *inputBuffer, const gr_complex *taps, long numTaps, long numOutputs) {
+		const long block = 32;	// 4 registers x 8 complex outputs
+		long blockedOutputs = (numOutputs / block) * block;
+		const float *tapValues = (const float *)taps;
+		const __m512 signs = _mm512_setr_ps(-1.0f,1.0f,-1.0f,1.0f,-1.0f,1.0f,-1.0f,1.0f,
+				-1.0f,1.0f,-1.0f,1.0f,-1.0f,1.0f,-1.0f,1.0f);
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m512 accR0 = _mm512_setzero_ps();
+			__m512 accR1 = _mm512_setzero_ps();
+			__m512 accR2 = _mm512_setzero_ps();
+			__m512 accR3 = _mm512_setzero_ps();
+			__m512 accI0 = _mm512_setzero_ps();
+			__m512 accI1 = _mm512_setzero_ps();
+			__m512 accI2 = _mm512_setzero_ps();
+			__m512 accI3 = _mm512_setzero_ps();
+			const float *in = (const float *)&inputBuffer[i];
+
+			for (long k=0;k<numTaps;k++) {
+				__m512 tapR = _mm512_set1_ps(tapValues[2*k]);
+				__m512 tapI = _mm512_set1_ps(tapValues[2*k+1]);
+				__m512 x0 = _mm512_loadu_ps(in);
+				__m512 x1 = _mm512_loadu_ps(in+16);
+				__m512 x2 = _mm512_loadu_ps(in+32);
+				__m512 x3 = _mm512_loadu_ps(in+48);
+
+				accR0 = _mm512_fmadd_ps(x0,tapR,accR0);
+				accR1 = _mm512_fmadd_ps(x1,tapR,accR1);
+				accR2 = _mm512_fmadd_ps(x2,tapR,accR2);
+				accR3 = _mm512_fmadd_ps(x3,tapR,accR3);
+				accI0 = _mm512_fmadd_ps(_mm512_permute_ps(x0,0xB1),tapI,accI0);
+				accI1 = _mm512_fmadd_ps(_mm512_permute_ps(x1,0xB1),tapI,accI1);
+				accI2 = _mm512_fmadd_ps(_mm512_permute_ps(x2,0xB1),tapI,accI2);
+				accI3 = _mm512_fmadd_ps(_mm512_permute_ps(x3,0xB1),tapI,accI3);
+				in += 2;
+			}
+
+			float *out = (float *)&outputBuffer[i];
+			_mm512_storeu_ps(out,_mm512_fmadd_ps(accI0,signs,accR0));
+			_mm512_storeu_ps(out+16,_mm512_fmadd_ps(accI1,signs,accR1));
+			_mm512_storeu_ps(out+32,_mm512_fmadd_ps(accI2,signs,accR2));
+			_mm512_storeu_ps(out+48,_mm512_fmadd_ps(accI3,signs,accR3));
+		}
+
+		return blockedOutputs;
+	}
+
+	// Folded kernels for symmetric / antisymmetric taps.  Both data types are run as floats:
+	// stride is 1 for float input and 2 for interleaved complex input with real taps.
+	__attribute__((target("avx512f")))
+	static long filterFolded_avx512(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, bool antisymmetric,
+			long numOutputs, long stride) {
+		const long block = 64 / stride;	// 4 registers of outputs
+		long blockedOutputs = (numOutputs / block) * block;
+		long halfTaps = numTaps / 2;
+		// Distance between mirrored samples, in floats
+		long mirror = (numTaps - 1) * stride;
+
+		for (long i=0;i<blockedOutputs;i+=block) {
+			__m512 acc0 = _mm512_setzero_ps();
+			__m512 acc1 = _mm512_setzero_ps();
+			__m512 acc2 = _mm512_setzero_ps();
+			__m512 acc3 = _mm512_setzero_ps();
+			const float *in = &inputBuffer[i*stride];
+
+			for (long k=0;k<halfTaps;k++) {
+				__m512 tap = _mm512_set1_ps(taps[k]);
+				const float *inMirror = in + mirror - 2*k*stride;
+				__m512 x0,x1,x2,x3;
+
+				if (antisymmetric) {
+					x0 = _mm512_sub_ps(_mm512_loadu_ps(in),_mm512_loadu_ps(inMirror));
+					x1 = _mm512_sub_ps(_mm512_loadu_ps(in+16),_mm512_loadu_ps(inMirror+16));
+					x2 = _mm512_sub_ps(_mm512_loadu_ps(in+32),_mm512_loadu_ps(inMirror+32));
+					x3 = _mm512_sub_ps(_mm512_loadu_ps(in+48),_mm512_loadu_ps(inMirror+48));
+				}
+				else {
+					x0 = _mm512_add_ps(_mm512_loadu_ps(in),_mm512_loadu_ps(inMirror));
+					x1 = _mm512_add_ps(_mm512_loadu_ps(in+16),_mm512_loadu_ps(inMirror+16));
+					x2 = _mm512_add_ps(_mm512_loadu_ps(in+32),_mm512_loadu_ps(inMirror+32));
+					x3 = _mm512_add_ps(_mm512_loadu_ps(in+48),_mm512_loadu_ps(inMirror+48));
+				}
+
+				acc0 = _mm512_fmadd_ps(x0,tap,acc0);
+				acc1 = _mm512_fmadd_ps(x1,tap,acc1);
+				acc2 = _mm512_fmadd_ps(x2,tap,acc2);
+				acc3 = _mm512_fmadd_ps(x3,tap,acc3);
+				in += stride;
+			}
+
+			// Odd length: the center tap has no mirror (and is 0 for antisymmetric taps)
+			if ((numTaps & 1) && !antisymmetric) {
+				__m512 tap = _mm512_set1_ps(taps[halfTaps]);
+				__m512 x0 = _mm512_loadu_ps(in);
+				__m512 x1 = _mm512_loadu_ps(in+16);
+				__m512 x2 = _mm512_loadu_ps(in+32);
+				__m512 x3 = _mm512_loadu_ps(in+48);
+
+				acc0 = _mm512_fmadd_ps(x0,tap,acc0);
+				acc1 = _mm512_fmadd_ps(x1,tap,acc1);
+				acc2 = _mm512_fmadd_ps(x2,tap,acc2);
+				acc3 = _mm512_fmadd_ps(x3,tap,acc3);
+			}
+
+			float *out = &outputBuffer[i*stride];
+			_mm512_storeu_ps(out,acc0);
+			_mm512_storeu_ps(out+16,acc1);
+			_mm512_storeu_ps(out+32,acc2);
+			_mm512_storeu_ps(out+48,acc3);
+		}
+
+		return blockedOutputs;
+	}
+
+	static long filterFolded(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, bool antisymmetric,
+			long numOutputs, long stride) {
+		switch (blockedKernelLevel()) {
+		case LFAST_KERNEL_AVX512:
+			return filterFolded_avx512(outputBuffer,inputBuffer,taps,numTaps,antisymmetric,numOutputs,stride);
+		case LFAST_KERNEL_AVX2:
+			return filterFolded_avx2(outputBuffer,inputBuffer,taps,numTaps,antisymmetric,numOutputs,stride);
+		case LFAST_KERNEL_SSE:
+			return filterFolded_sse(outputBuffer,inputBuffer,taps,numTaps,antisymmetric,numOutputs,stride);
+		}
+
+		return 0;
+	}
+
+	static int detectKernelLevel() {
+		__builtin_cpu_init();
+
+		// AVX-512 level also runs the AVX2 int16 kernels
+		if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2"))
+			return LFAST_KERNEL_AVX512;
+
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+			return LFAST_KERNEL_AVX2;
+
+		if (__builtin_cpu_supports("sse2"))
+			return LFAST_KERNEL_SSE;
+
+		return LFAST_KERNEL_NONE;
+	}
+#else
+	static int detectKernelLevel() {
+		return LFAST_KERNEL_NONE;
+	}
+#endif
+
+	static int detectedLevel() {
+		static int level = detectKernelLevel();
+
+		return level;
+	}
+
+	static int activeLevel = -1;
+
+	int blockedKernelLevel() {
+		if (activeLevel < 0)
+			activeLevel = detectedLevel();
+
+		return activeLevel;
+	}
+
+	void setBlockedKernelLevel(int level) {
+		if (level < LFAST_KERNEL_NONE)
+			level = LFAST_KERNEL_NONE;
+
+		if (level > detectedLevel())
+			level = detectedLevel();
+
+		activeLevel = level;
+	}
+
+	const char *blockedKernelName(int level) {
+		switch (level) {
+		case LFAST_KERNEL_SSE:
+			return "SSE";
+		case LFAST_KERNEL_AVX2:
+			return "AVX2/FMA";
+		case LFAST_KERNEL_AVX512:
+			return "AVX-512";
+		default:
+			return "none";
+		}
+	}
+
+	long blockedFilterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, const float *taps, long numTaps, long numOutputs) {
+#if defined(LFAST_X86_KERNELS)
+		switch (blockedKernelLevel()) {
+		case LFAST_KERNEL_AVX512:
+			return filterCCF_avx512(outputBuffer,inputBuffer,taps,numTaps,numOutputs);
+		case LFAST_KERNEL_AVX2:
+			return filterCCF_avx2(outputBuffer,inputBuffer,taps,numTaps,numOutputs);
+		case LFAST_KERNEL_SSE:
+			return filterCCF_sse(outputBuffer,inputBuffer,taps,numTaps,numOutputs);
+		}
+#endif
+		return 0;
+	}
+
+	long blockedFilterN(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, long numOutputs) {
+#if defined(LFAST_X86_KERNELS)
+		switch (blockedKernelLevel()) {
+		case LFAST_KERNEL_AVX512:
+			return filterFFF_avx512(outputBuffer,inputBuffer,taps,numTaps,numOutputs);
+		case LFAST_KERNEL_AVX2:
+			return filterFFF_avx2(outputBuffer,inputBuffer,taps,numTaps,numOutputs);
+		case LFAST_KERNEL_SSE:
+			return filterFFF_sse(outputBuffer,inputBuffer,taps,numTaps,numOutputs);
+		}
+#endif
+		return 0;
+	}
+
+	long blockedFilterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, const gr_complex *taps, long numTaps, long numOutputs) {
+#if defined(LFAST_X86_KERNELS)
+		switch (blockedKernelLevel()) {
+		case LFAST_KERNEL_AVX512:
+			return filterCCC_avx512(outputBuffer,inputBuffer,taps,numTaps,numOutputs);
+		case LFAST_KERNEL_AVX2:
+			return filterCCC_avx2(outputBuffer,inputBuffer,taps,numTaps,numOutputs);
+		case LFAST_KERNEL_SSE:
+			return filterCCC_sse(outputBuffer,inputBuffer,taps,numTaps,numOutputs);
+		}
+#endif
+		return 0;
+	}
+
+	long foldedFilterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, const float *taps, long numTaps, bool antisymmetric, long numOutputs) {
+#if defined(LFAST_X86_KERNELS)
+		return filterFolded((float *)outputBuffer,(const float *)inputBuffer,taps,numTaps,antisymmetric,numOutputs,2);
+#else
+		return 0;
+#endif
+	}
+
+	long foldedFilterN(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, bool antisymmetric, long numOutputs) {
+#if defined(LFAST_X86_KERNELS)
+		return filterFolded(outputBuffer,inputBuffer,taps,numTaps,antisymmetric,numOutputs,1);
+#else
+		return 0;
+#endif
+	}
+
+	long blockedAccumulateS16(int32_t *accI, int32_t *accQ, const int32_t *pairsI, const int32_t *pairsQ,
+			const int32_t *tapPairs, long numTapPairs, long numOutputs) {
+#if defined(LFAST_X86_KERNELS)
+		switch (blockedKernelLevel()) {
+		// The 512-bit int16 multiply-add needs AVX-512BW, so AVX-512 machines run the AVX2 version
+		case LFAST_KERNEL_AVX512:
+		case LFAST_KERNEL_AVX2:
+			return accumulateS16_avx2(accI,accQ,pairsI,pairsQ,tapPairs,numTapPairs,numOutputs);
+		case LFAST_KERNEL_SSE:
+			return accumulateS16_sse(accI,accQ,pairsI,pairsQ,tapPairs,numTapPairs,numOutputs);
+		}
+#endif
+		return 0;
+	}
+
+  } // end lfast
+} // end gr
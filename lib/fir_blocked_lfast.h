@@ -0,0 +1,80 @@
+/*
+ * fir_blocked_lfast.h
+ *
+ *      Copyright 2019, Michael Piscopo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIB_FIR_BLOCKED_LFAST_H_
+#define LIB_FIR_BLOCKED_LFAST_H_
+
+#include <gnuradio/gr_complex.h>
+#include <stdint.h>
+
+// Instruction set levels for the blocked kernels
+#define LFAST_KERNEL_NONE 0
+#define LFAST_KERNEL_SSE 1
+#define LFAST_KERNEL_AVX2 2
+#define LFAST_KERNEL_AVX512 3
+
+namespace gr {
+  namespace lfast {
+	/*
+	 * Register-blocked FIR kernels.
+	 * Rather than one dot product per output (reloading every tap for every output),
+	 * each pass over the taps accumulates a block of consecutive outputs in SIMD registers:
+	 * every tap is broadcast once and multiplied against the input vectors for the whole block.
+	 *
+	 * taps are the reversed taps as stored by Filter, so
+	 * output[i] = sum over k of input[i+k] * taps[k], exactly as the dot product versions.
+	 *
+	 * Each call computes the largest multiple of the block size <= numOutputs and returns
+	 * how many outputs it wrote.  The caller finishes the rest with dot products.
+	 * Returns 0 if no SIMD level is available (non-x86 builds).
+	 */
+	long blockedFilterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, const float *taps, long numTaps, long numOutputs);
+	long blockedFilterN(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, long numOutputs);
+	long blockedFilterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, const gr_complex *taps, long numTaps, long numOutputs);
+
+	/*
+	 * Folded versions for linear-phase (symmetric or antisymmetric) real taps.
+	 * Mirrored input samples are added (subtracted for antisymmetric taps) before the multiply,
+	 * so only the first half of the taps (plus the center tap for odd lengths) is applied.
+	 * Same calling convention and return value as blockedFilterN.
+	 */
+	long foldedFilterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, const float *taps, long numTaps, bool antisymmetric, long numOutputs);
+	long foldedFilterN(float *outputBuffer, const float *inputBuffer, const float *taps, long numTaps, bool antisymmetric, long numOutputs);
+
+	/*
+	 * int16 pair kernel for FIRFilterSCS.  Each int32 word holds two int16 values, low half first.
+	 * pairs[m] = (plane[m], plane[m+1]) for one plane (I or Q) of the input and
+	 * tapPairs[j] = (taps[2j], taps[2j+1]), so one pmaddwd-style multiply-add applies two taps.
+	 * Adds sum over j of tapPairs[j] . pairs[n+2j] into acc[n] for both planes with int32 accumulation.
+	 * Same return value as blockedFilterN.
+	 */
+	long blockedAccumulateS16(int32_t *accI, int32_t *accQ, const int32_t *pairsI, const int32_t *pairsQ,
+			const int32_t *tapPairs, long numTapPairs, long numOutputs);
+
+	// Level picked from the CPU features at startup
+	int blockedKernelLevel();
+
+	// Limits the level used (e.g. for timing comparisons).  Can't go above what the CPU supports.
+	void setBlockedKernelLevel(int level);
+
+	const char *blockedKernelName(int level);
+  } // end lfast
+} // end gr
+
+#endif /* LIB_FIR_BLOCKED_LFAST_H_ */
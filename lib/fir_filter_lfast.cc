@@ -6,18 +6,41 @@
 
 #include "fir_filter_lfast.h"
 #include "scomplex.h"
+#include <stdexcept>
 
 namespace gr {
   namespace lfast {
   template<class io_type, class tap_type> Filter<io_type,tap_type>::Filter() {
 	alignedTaps = NULL;
+	alignmentSamples = 1;
+	alignmentMask = 0;
 	numTaps = 0;
+	polyphaseDecimation = 1;
+	maxPolyphaseLength = 0;
+	blockedKernel = true;
+	symmetryMode = LFAST_SYMMETRY_AUTO;
+	tapSymmetry = LFAST_TAPS_ASYMMETRIC;
+	stitchBuffer = NULL;
+	stitchBufferSize = 0;
+	streamRing = NULL;
+	ringHead = 0;
 	size_t memAlignment = volk_get_alignment();
 	singlePointBuffer = (io_type *)volk_malloc(1*sizeof(io_type),memAlignment);
   }
 
   template<class io_type, class tap_type> Filter<io_type,tap_type>::Filter(const std::vector<tap_type>& newTaps) {
 	alignedTaps = NULL;
+	alignmentSamples = 1;
+	alignmentMask = 0;
+	polyphaseDecimation = 1;
+	maxPolyphaseLength = 0;
+	blockedKernel = true;
+	symmetryMode = LFAST_SYMMETRY_AUTO;
+	tapSymmetry = LFAST_TAPS_ASYMMETRIC;
+	stitchBuffer = NULL;
+	stitchBufferSize = 0;
+	streamRing = NULL;
+	ringHead = 0;
 	size_t memAlignment = volk_get_alignment();
 	singlePointBuffer = (io_type *)volk_malloc(1*sizeof(io_type),memAlignment);
 
@@ -25,15 +48,127 @@ namespace gr {
   }
 
   template<class io_type, class tap_type> Filter<io_type,tap_type>::~Filter() {
-		if (alignedTaps) {
-			volk_free(alignedTaps);
-			alignedTaps = NULL;
-		}
+		freeAlignedTapSets();
+
+		freePolyphaseTaps();
+
+		if (stitchBuffer)
+			volk_free(stitchBuffer);
+
+		if (streamRing)
+			delete streamRing;
 
 		volk_free(singlePointBuffer);
   }
 
+  template<class io_type, class tap_type> long Filter<io_type,tap_type>::filterN(io_type *outputBuffer, const io_type *inputBuffer, long numSamples) {
+		for (long i=0;i<numSamples;i++) {
+			alignedDotProd(&outputBuffer[i],&inputBuffer[i]);
+		}
+
+		return numSamples;
+  }
+
+  template<class io_type, class tap_type> void Filter<io_type,tap_type>::resetHistory() {
+		std::fill(streamHistory.begin(),streamHistory.end(),io_type(0));
+
+		if (streamRing)
+			std::fill(streamRing->at(0),streamRing->at(0) + streamRing->capacity(),io_type(0));
+  }
+
+  template<class io_type, class tap_type> long Filter<io_type,tap_type>::push(const io_type *inputBuffer, long numSamples, io_type *outputBuffer) {
+		long historyLength = std::max(0L,numTaps - 1);
+
+		// Taps changed length: keep the most recent samples
+		if ((long)streamHistory.size() > historyLength)
+			streamHistory.erase(streamHistory.begin(),streamHistory.begin() + (streamHistory.size() - historyLength));
+		else if ((long)streamHistory.size() < historyLength)
+			streamHistory.insert(streamHistory.begin(),historyLength - streamHistory.size(),io_type(0));
+
+		if (numSamples <= 0)
+			return 0;
+
+		// The aligned kernels read back to the aligned address below each window, so windows starting before
+		// the first aligned address in inputBuffer are also taken from the joined copy.
+		long alignment = alignmentMask + 1;
+		long toAligned = ((alignment - ((size_t)inputBuffer & alignmentMask)) & alignmentMask) / sizeof(io_type);
+		long joinedOutputs = std::min(numSamples,historyLength + toAligned);
+		long joinedLength = historyLength + joinedOutputs;
+
+		if (stitchBufferSize < joinedLength) {
+			if (stitchBuffer)
+				volk_free(stitchBuffer);
+
+			stitchBuffer = (io_type *)volk_malloc(joinedLength*sizeof(io_type),volk_get_alignment());
+			stitchBufferSize = joinedLength;
+		}
+
+		std::copy(streamHistory.begin(),streamHistory.end(),stitchBuffer);
+		std::copy(inputBuffer,inputBuffer + joinedOutputs,stitchBuffer + historyLength);
+
+		filterN(outputBuffer,stitchBuffer,joinedOutputs);
+
+		if (numSamples > joinedOutputs)
+			filterN(&outputBuffer[joinedOutputs],&inputBuffer[joinedOutputs - historyLength],numSamples - joinedOutputs);
+
+		// Keep the last historyLength samples of history + input
+		if (numSamples >= historyLength) {
+			std::copy(inputBuffer + numSamples - historyLength,inputBuffer + numSamples,streamHistory.begin());
+		}
+		else {
+			std::copy(streamHistory.begin() + numSamples,streamHistory.end(),streamHistory.begin());
+			std::copy(inputBuffer,inputBuffer + numSamples,streamHistory.end() - numSamples);
+		}
+
+		return numSamples;
+  }
+
+  template<class io_type, class tap_type> io_type *Filter<io_type,tap_type>::getWriteBuffer(long numSamples) {
+		size_t historyLength = std::max(0L,numTaps - 1);
+		size_t required = historyLength + std::max(1L,numSamples);
+
+		if (!streamRing || streamRing->capacity() < required) {
+			// Sized for a few calls' worth so steady chunk sizes never come back here
+			MirroredBuffer<io_type> *newRing = new MirroredBuffer<io_type>(std::max(required*4,(size_t)8192));
+
+			if (streamRing) {
+				size_t historyStart = ringHead + streamRing->capacity() - historyLength;
+				std::copy(streamRing->at(historyStart),streamRing->at(historyStart) + historyLength,newRing->at(0));
+				delete streamRing;
+			}
+
+			streamRing = newRing;
+			ringHead = historyLength;
+		}
+
+		return streamRing->at(ringHead);
+  }
+
+  template<class io_type, class tap_type> long Filter<io_type,tap_type>::pushWritten(long numSamples, io_type *outputBuffer) {
+		if (numSamples <= 0)
+			return 0;
+
+		size_t historyLength = std::max(0L,numTaps - 1);
+
+		// The samples are already in place if getWriteBuffer() was called with at least numSamples
+		if (!streamRing || streamRing->capacity() < historyLength + numSamples)
+			throw std::invalid_argument("Filter::pushWritten: call getWriteBuffer() with at least numSamples first");
+
+		// Page-aligned mapping, so the aligned kernels' read-back stays inside it
+		size_t windowStart = ringHead + streamRing->capacity() - historyLength;
+
+		filterN(outputBuffer,streamRing->at(windowStart),numSamples);
+
+		ringHead = (ringHead + numSamples) % streamRing->capacity();
+
+		return numSamples;
+  }
+
   template<class io_type, class tap_type> std::vector<tap_type> Filter<io_type,tap_type>::getTaps() const {
+		return userTaps;
+  }
+
+  template<class io_type, class tap_type> std::vector<tap_type> Filter<io_type,tap_type>::getAppliedTaps() const {
 		// Need to reverse it to return the true taps
 	    std::vector<tap_type> revTaps = d_taps;
 		std::reverse(revTaps.begin(), revTaps.end());
@@ -44,19 +179,204 @@ namespace gr {
   template<class io_type, class tap_type> void Filter<io_type,tap_type>::setTaps(const std::vector<tap_type>& newTaps) {
 		// For a FIR filter, the taps have to be reversed to be applied.
 		// Reversing them here makes it easy when we call the volk routine.
+		userTaps = newTaps;
 		d_taps = newTaps;
 		std::reverse(d_taps.begin(), d_taps.end());
 
+		numTaps = d_taps.size();
+
+		checkSymmetry();
+
 		// mem align taps for better SIMD performance
-		if (alignedTaps) {
-			volk_free(alignedTaps);
+		buildAlignedTapSets();
+
+		if (polyphaseDecimation > 1)
+			buildPolyphaseTaps();
+  }
+
+  template<class io_type, class tap_type> void Filter<io_type,tap_type>::swapTaps(Filter<io_type,tap_type> &other) {
+		d_taps.swap(other.d_taps);
+		userTaps.swap(other.userTaps);
+		std::swap(numTaps,other.numTaps);
+
+		alignedTapSets.swap(other.alignedTapSets);
+		std::swap(alignedTaps,other.alignedTaps);
+		std::swap(alignmentSamples,other.alignmentSamples);
+		std::swap(alignmentMask,other.alignmentMask);
+		std::swap(tapSymmetry,other.tapSymmetry);
+
+		std::swap(polyphaseDecimation,other.polyphaseDecimation);
+		polyphaseTaps.swap(other.polyphaseTaps);
+		polyphaseLength.swap(other.polyphaseLength);
+		std::swap(maxPolyphaseLength,other.maxPolyphaseLength);
+  }
+
+  template<class io_type, class tap_type> void Filter<io_type,tap_type>::checkSymmetry() {
+		tapSymmetry = LFAST_TAPS_ASYMMETRIC;
+
+		if ((numTaps < 2) || (symmetryMode == LFAST_SYMMETRY_OFF))
+			return;
+
+		// Compare mirrored pairs relative to the largest tap so designed filters that differ
+		// in the last bit or two still count as symmetric.
+		double maxTap = 0.0;
+		double symmetricError = 0.0;
+		double antisymmetricError = 0.0;
+
+		for (long i=0;i<numTaps;i++) {
+			maxTap = std::max(maxTap,(double)std::abs(d_taps[i]));
+			symmetricError = std::max(symmetricError,(double)std::abs(d_taps[i] - d_taps[numTaps-1-i]));
+			antisymmetricError = std::max(antisymmetricError,(double)std::abs(d_taps[i] + d_taps[numTaps-1-i]));
 		}
 
-		numTaps = d_taps.size();
+		if (maxTap == 0.0)
+			return;
+
+		double tolerance = 1e-6 * maxTap;
+
+		if (symmetricError <= tolerance) {
+			tapSymmetry = LFAST_TAPS_SYMMETRIC;
+		}
+		else if (antisymmetricError <= tolerance) {
+			tapSymmetry = LFAST_TAPS_ANTISYMMETRIC;
+		}
+		else if (symmetryMode == LFAST_SYMMETRY_FORCE) {
+			// Keep the dominant part so filterN and the dot product paths agree on the taps
+			tapSymmetry = (symmetricError <= antisymmetricError) ? LFAST_TAPS_SYMMETRIC : LFAST_TAPS_ANTISYMMETRIC;
+			tap_type sign = (tapSymmetry == LFAST_TAPS_SYMMETRIC) ? tap_type(1) : tap_type(-1);
+
+			for (long i=0;i<numTaps/2;i++) {
+				tap_type value = (d_taps[i] + sign * d_taps[numTaps-1-i]) * tap_type(0.5);
+				d_taps[i] = value;
+				d_taps[numTaps-1-i] = sign * value;
+			}
+
+			if ((numTaps & 1) && (tapSymmetry == LFAST_TAPS_ANTISYMMETRIC))
+				d_taps[numTaps/2] = tap_type(0);
+		}
+  }
+
+  template<class io_type, class tap_type> void Filter<io_type,tap_type>::setSymmetryMode(int mode) {
+		symmetryMode = mode;
+
+		// Copy first: setTaps assigns userTaps from its argument
+		if (numTaps > 0)
+			setTaps(std::vector<tap_type>(userTaps));
+  }
+
+  template<class io_type, class tap_type> void Filter<io_type,tap_type>::freeAlignedTapSets() {
+		for (size_t i=0;i<alignedTapSets.size();i++) {
+			volk_free(alignedTapSets[i]);
+		}
+
+		alignedTapSets.clear();
+		alignedTaps = NULL;
+  }
+
+  template<class io_type, class tap_type> void Filter<io_type,tap_type>::buildAlignedTapSets() {
+		freeAlignedTapSets();
+
+		size_t memAlignment = volk_get_alignment();
+
+		alignmentSamples = memAlignment / sizeof(io_type);
+
+		if (alignmentSamples < 1)
+			alignmentSamples = 1;
+
+		alignmentMask = memAlignment - 1;
+
+		long setLength = numTaps + alignmentSamples - 1;
+
+		for (int k=0;k<alignmentSamples;k++) {
+			tap_type *tapSet = (tap_type *)volk_malloc(setLength*sizeof(tap_type),memAlignment);
+
+			std::fill_n(tapSet,setLength,tap_type(0));
+
+			for (long i=0;i<numTaps;i++)
+				tapSet[k+i] = d_taps[i];
+
+			alignedTapSets.push_back(tapSet);
+		}
+
+		alignedTaps = alignedTapSets[0];
+  }
+
+  template<class io_type, class tap_type> std::string Filter<io_type,tap_type>::getKernelInfo() const {
+		std::string info = dotProdAlignedName((const io_type *)NULL,(const tap_type *)NULL);
+
+		info += " (volk machine ";
+		info += volk_get_machine();
+		info += "), ";
+		info += std::to_string(getAlignment());
+		info += "-byte alignment, ";
+		info += std::to_string(alignmentSamples);
+		info += " tap copies";
+
+		if (blockedKernel && blockedKernelLevel() != LFAST_KERNEL_NONE) {
+			info += ", blocked ";
+			info += blockedKernelName(blockedKernelLevel());
+			info += " kernel";
+		}
+
+		if (tapSymmetry == LFAST_TAPS_SYMMETRIC)
+			info += ", symmetric taps";
+		else if (tapSymmetry == LFAST_TAPS_ANTISYMMETRIC)
+			info += ", antisymmetric taps";
+
+		return info;
+  }
+
+  template<class io_type, class tap_type> void Filter<io_type,tap_type>::setPolyphaseDecimation(int decimation) {
+		if (decimation < 1)
+			decimation = 1;
+
+		polyphaseDecimation = decimation;
+
+		if (polyphaseDecimation > 1)
+			buildPolyphaseTaps();
+		else
+			freePolyphaseTaps();
+  }
+
+  template<class io_type, class tap_type> void Filter<io_type,tap_type>::freePolyphaseTaps() {
+		for (size_t i=0;i<polyphaseTaps.size();i++) {
+			if (polyphaseTaps[i])
+				volk_free(polyphaseTaps[i]);
+		}
+
+		polyphaseTaps.clear();
+		polyphaseLength.clear();
+		maxPolyphaseLength = 0;
+  }
+
+  template<class io_type, class tap_type> void Filter<io_type,tap_type>::buildPolyphaseTaps() {
+		freePolyphaseTaps();
 
 		size_t memAlignment = volk_get_alignment();
-		alignedTaps = (tap_type *)volk_malloc(numTaps*sizeof(tap_type),memAlignment);
-		memcpy(alignedTaps,&d_taps[0],numTaps*sizeof(tap_type));
+
+		// d_taps is already reversed, so output i = sum over p of
+		// dot(input[i*D+p], input[(i+1)*D+p], ...) with d_taps[p], d_taps[p+D], ...
+		for (int p=0;p<polyphaseDecimation;p++) {
+			long subLength = 0;
+
+			if (p < numTaps)
+				subLength = (numTaps - p + polyphaseDecimation - 1) / polyphaseDecimation;
+
+			tap_type *subTaps = NULL;
+
+			if (subLength > 0) {
+				subTaps = (tap_type *)volk_malloc(subLength*sizeof(tap_type),memAlignment);
+
+				for (long k=0;k<subLength;k++)
+					subTaps[k] = d_taps[p + k*polyphaseDecimation];
+			}
+
+			polyphaseTaps.push_back(subTaps);
+			polyphaseLength.push_back(subLength);
+
+			if (subLength > maxPolyphaseLength)
+				maxPolyphaseLength = subLength;
+		}
   }
 
   // -------------------------------------------
@@ -72,21 +392,27 @@ namespace gr {
   	const gr_complex *in;
   	gr_complex *out;
 
+  	// The blocked kernel does as many whole register blocks as it can, the dot products finish the rest.
+  	long i;
+
+  	if (useFolded())
+  		i = foldedFilterN(outputBuffer,inputBuffer,alignedTaps,numTaps,tapSymmetry == LFAST_TAPS_ANTISYMMETRIC,numSamples);
+  	else
+  		i = blockedKernel ? blockedFilterN(outputBuffer,inputBuffer,alignedTaps,numTaps,numSamples) : 0;
+
   	// Using the pointers saves the offset dereferencing so it's slightly faster.
-  	in=inputBuffer;
-  	out=outputBuffer;
+  	in=&inputBuffer[i];
+  	out=&outputBuffer[i];
 
-  	for (long i=0;i<numSamples;i++) {
-  		// volk_32fc_32f_dot_prod_32fc_a(&outputBuffer[i],&inputBuffer[i],&alignedTaps[0],numTaps);
-  		// volk_32fc_32f_dot_prod_32fc_a(out++,in++,&alignedTaps[0],numTaps);
-  		volk_32fc_32f_dot_prod_32fc(out++,in++,&alignedTaps[0],numTaps);
+  	for (;i<numSamples;i++) {
+  		alignedDotProd(out++,in++);
   	}
 
   	return numSamples;
   }
 
   gr_complex FIRFilterCCF::filter(const gr_complex *inputBuffer) {
-		volk_32fc_32f_dot_prod_32fc(singlePointBuffer,inputBuffer,&alignedTaps[0],numTaps);
+		alignedDotProd(singlePointBuffer,inputBuffer);
 
 		return *singlePointBuffer;
   }
@@ -98,13 +424,51 @@ namespace gr {
   	long j=0;
 
   	for (long i=0;i<decimatedCount;i++) {
-  		volk_32fc_32f_dot_prod_32fc(&outputBuffer[i],&inputBuffer[j],&alignedTaps[0],numTaps);
+  		alignedDotProd(&outputBuffer[i],&inputBuffer[j]);
   		j+= decimation;
   	}
 
   	return decimatedCount;
   }
 
+  long FIRFilterCCF::filterNdecPolyphase(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation, gr_complex *laneBuffer) {
+	if (decimation <= 1 || decimation != polyphaseDecimation)
+		return FIRFilterCCF::filterNdec(outputBuffer,inputBuffer,numSamples,decimation);
+
+  	long decimatedCount = numSamples / decimation;
+  	gr_complex partial;
+
+  	// Work one phase at a time so both the sub-filter and its lane stay in cache.
+  	for (int p=0;p<decimation;p++) {
+  		long subLength = polyphaseLength[p];
+
+  		if (subLength == 0)
+  			continue;
+
+  		long laneLength = decimatedCount + subLength - 1;
+  		const gr_complex *in = &inputBuffer[p];
+
+  		for (long n=0;n<laneLength;n++) {
+  			laneBuffer[n] = *in;
+  			in += decimation;
+  		}
+
+  		if (p == 0) {
+  	  		for (long i=0;i<decimatedCount;i++) {
+  	  			volk_32fc_32f_dot_prod_32fc(&outputBuffer[i],&laneBuffer[i],polyphaseTaps[p],subLength);
+  	  		}
+  		}
+  		else {
+  	  		for (long i=0;i<decimatedCount;i++) {
+  	  			volk_32fc_32f_dot_prod_32fc(&partial,&laneBuffer[i],polyphaseTaps[p],subLength);
+  	  			outputBuffer[i] += partial;
+  	  		}
+  		}
+  	}
+
+  	return decimatedCount;
+  }
+
   long FIRFilterCCF::filterCPU(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples) {
 
   	long index;
@@ -150,19 +514,27 @@ namespace gr {
   	const float *in;
   	float *out;
 
+  	// The blocked kernel does as many whole register blocks as it can, the dot products finish the rest.
+  	long i;
+
+  	if (useFolded())
+  		i = foldedFilterN(outputBuffer,inputBuffer,alignedTaps,numTaps,tapSymmetry == LFAST_TAPS_ANTISYMMETRIC,numSamples);
+  	else
+  		i = blockedKernel ? blockedFilterN(outputBuffer,inputBuffer,alignedTaps,numTaps,numSamples) : 0;
+
   	// Using the pointers saves the offset dereferencing so it's slightly faster.
-  	in=inputBuffer;
-  	out=outputBuffer;
+  	in=&inputBuffer[i];
+  	out=&outputBuffer[i];
 
-  	for (long i=0;i<numSamples;i++) {
-  		volk_32f_x2_dot_prod_32f(out++,in++,&alignedTaps[0],numTaps);
+  	for (;i<numSamples;i++) {
+  		alignedDotProd(out++,in++);
   	}
 
   	return numSamples;
   }
 
   gr_complex FIRFilterFFF::filter(const float *inputBuffer) {
-	  volk_32f_x2_dot_prod_32f(singlePointBuffer,inputBuffer,&alignedTaps[0],numTaps);
+	  alignedDotProd(singlePointBuffer,inputBuffer);
 
 	  return *singlePointBuffer;
   }
@@ -174,13 +546,51 @@ namespace gr {
   	long j=0;
 
   	for (long i=0;i<decimatedCount;i++) {
-  		volk_32f_x2_dot_prod_32f(&outputBuffer[i],&inputBuffer[j],&alignedTaps[0],numTaps);
+  		alignedDotProd(&outputBuffer[i],&inputBuffer[j]);
   		j+= decimation;
   	}
 
   	return decimatedCount;
   }
 
+  long FIRFilterFFF::filterNdecPolyphase(float *outputBuffer, const float *inputBuffer, long numSamples, int decimation, float *laneBuffer) {
+	if (decimation <= 1 || decimation != polyphaseDecimation)
+		return FIRFilterFFF::filterNdec(outputBuffer,inputBuffer,numSamples,decimation);
+
+  	long decimatedCount = numSamples / decimation;
+  	float partial;
+
+  	// Work one phase at a time so both the sub-filter and its lane stay in cache.
+  	for (int p=0;p<decimation;p++) {
+  		long subLength = polyphaseLength[p];
+
+  		if (subLength == 0)
+  			continue;
+
+  		long laneLength = decimatedCount + subLength - 1;
+  		const float *in = &inputBuffer[p];
+
+  		for (long n=0;n<laneLength;n++) {
+  			laneBuffer[n] = *in;
+  			in += decimation;
+  		}
+
+  		if (p == 0) {
+  	  		for (long i=0;i<decimatedCount;i++) {
+  	  			volk_32f_x2_dot_prod_32f(&outputBuffer[i],&laneBuffer[i],polyphaseTaps[p],subLength);
+  	  		}
+  		}
+  		else {
+  	  		for (long i=0;i<decimatedCount;i++) {
+  	  			volk_32f_x2_dot_prod_32f(&partial,&laneBuffer[i],polyphaseTaps[p],subLength);
+  	  			outputBuffer[i] += partial;
+  	  		}
+  		}
+  	}
+
+  	return decimatedCount;
+  }
+
   long FIRFilterFFF::filterCPU(float *outputBuffer, const float *inputBuffer, long numSamples) {
 
   	long index;
@@ -219,19 +629,22 @@ namespace gr {
   	const gr_complex *in;
   	gr_complex *out;
 
+  	// The blocked kernel does as many whole register blocks as it can, the dot products finish the rest.
+  	long i = blockedKernel ? blockedFilterN(outputBuffer,inputBuffer,alignedTaps,numTaps,numSamples) : 0;
+
   	// Using the pointers saves the offset dereferencing so it's slightly faster.
-  	in=inputBuffer;
-  	out=outputBuffer;
+  	in=&inputBuffer[i];
+  	out=&outputBuffer[i];
 
-  	for (long i=0;i<numSamples;i++) {
-  		volk_32fc_x2_dot_prod_32fc(out++,in++,&alignedTaps[0],numTaps);
+  	for (;i<numSamples;i++) {
+  		alignedDotProd(out++,in++);
   	}
 
   	return numSamples;
   }
 
   gr_complex FIRFilterCCC::filter(const gr_complex *inputBuffer) {
-	  volk_32fc_x2_dot_prod_32fc(singlePointBuffer,inputBuffer,&alignedTaps[0],numTaps);
+	  alignedDotProd(singlePointBuffer,inputBuffer);
 
 	  return *singlePointBuffer;
   }
@@ -243,13 +656,51 @@ namespace gr {
   	long j=0;
 
   	for (long i=0;i<decimatedCount;i++) {
-  		volk_32fc_x2_dot_prod_32fc(&outputBuffer[i],&inputBuffer[j],&alignedTaps[0],numTaps);
+  		alignedDotProd(&outputBuffer[i],&inputBuffer[j]);
   		j+= decimation;
   	}
 
   	return decimatedCount;
   }
 
+  long FIRFilterCCC::filterNdecPolyphase(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation, gr_complex *laneBuffer) {
+	if (decimation <= 1 || decimation != polyphaseDecimation)
+		return FIRFilterCCC::filterNdec(outputBuffer,inputBuffer,numSamples,decimation);
+
+  	long decimatedCount = numSamples / decimation;
+  	gr_complex partial;
+
+  	// Work one phase at a time so both the sub-filter and its lane stay in cache.
+  	for (int p=0;p<decimation;p++) {
+  		long subLength = polyphaseLength[p];
+
+  		if (subLength == 0)
+  			continue;
+
+  		long laneLength = decimatedCount + subLength - 1;
+  		const gr_complex *in = &inputBuffer[p];
+
+  		for (long n=0;n<laneLength;n++) {
+  			laneBuffer[n] = *in;
+  			in += decimation;
+  		}
+
+  		if (p == 0) {
+  	  		for (long i=0;i<decimatedCount;i++) {
+  	  			volk_32fc_x2_dot_prod_32fc(&outputBuffer[i],&laneBuffer[i],polyphaseTaps[p],subLength);
+  	  		}
+  		}
+  		else {
+  	  		for (long i=0;i<decimatedCount;i++) {
+  	  			volk_32fc_x2_dot_prod_32fc(&partial,&laneBuffer[i],polyphaseTaps[p],subLength);
+  	  			outputBuffer[i] += partial;
+  	  		}
+  		}
+  	}
+
+  	return decimatedCount;
+  }
+
   long FIRFilterCCC::filterCPU(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples) {
 
   	long index;
@@ -281,466 +732,544 @@ namespace gr {
   // -----------------------------------------------------------------
 
 	/*
-	 * Multi-threaded Complex FIR Filter with float taps
+	 * Multi-threaded base.  A persistent pool of worker threads that
+	 * parallelFor() splits work across.
 	 *
 	 */
 
-	template<class io_type> MTBase<io_type>::MTBase(int nthreads) {
+	MTBase::MTBase(int nthreads) {
+        threadsPending = 0;
+        d_nthreads = 1;
+        chunkFunction = NULL;
+        chunkContext = NULL;
+        runItems = 0;
+        runChunkSize = 1;
+        nextIndex = 0;
+        chunkSize = LFAST_CHUNK_AUTO;
+        affinityPolicy = LFAST_AFFINITY_NONE;
+        affinityPending = false;
+
+        // Thread 0 is always the calling thread.
+        workers.resize(1);
+        workers[0].thread = NULL;
+        workers[0].running = false;
+        workers[0].exit = false;
+        workers[0].chunksRun = 0;
+
 		setThreads(nthreads);
-		decimation = 1;
 	}
 
-	template<class io_type> void MTBase<io_type>::setThreads(int nthreads) {
+	int MTBase::maxThreads() {
+		int hwThreads = boost::thread::hardware_concurrency();
+
+		if (hwThreads < 1)
+			hwThreads = 1;
+
+		return hwThreads;
+	}
+
+	void MTBase::setThreads(int nthreads) {
         if (nthreads<1)
         	nthreads=1;
-        else if (nthreads > 16)
-        	nthreads = 16;
+        else if (nthreads > maxThreads())
+        	nthreads = maxThreads();
 
-        d_nthreads = nthreads;
+        for (int i=nthreads;i<(int)workers.size();i++) {
+        	stopThread(i);
+        }
+
+        int oldSize = workers.size();
 
-        for (int i=0;i<16;i++) {
-        	threadRunning[i] = false;
-        	threads[i] = NULL;
+        {
+        	boost::lock_guard<boost::mutex> lock(poolMutex);
+        	workers.resize(nthreads);
         }
 
-        threadReady = true;
+        // Block 0 always runs on the calling thread, so the pool only needs workers 1..nthreads-1.
+        for (int i=oldSize;i<nthreads;i++) {
+        	workers[i].running = false;
+        	workers[i].exit = false;
+        	workers[i].chunksRun = 0;
+        	workers[i].thread = new boost::thread(boost::bind(&MTBase::threadLoop, this,i));
+        }
+
+        d_nthreads = nthreads;
+
+        // New workers need placing too
+        if (affinityPolicy != LFAST_AFFINITY_NONE)
+        	affinityPending = true;
+	}
+
+	void MTBase::setAffinity(int policy, const std::vector<int> &cores) {
+		affinityPolicy = policy;
+		affinityCores = cores;
+		affinityPending = true;
+	}
+
+	void MTBase::applyAffinity() {
+		affinityPending = false;
+
+		if (workers.size() < 2)
+			return;
+
+		std::vector<std::vector<int> > cpuSets = workerCpuSets(affinityPolicy,affinityCores,workers.size()-1);
+
+		// No policy (or no topology): let them float over everything the process may use
+		if (cpuSets.empty())
+			cpuSets.assign(workers.size()-1,allowedCpus());
+
+		for (size_t i=1;i<workers.size();i++)
+			setThreadAffinity(workers[i].thread,cpuSets[i-1]);
+	}
+
+	void MTBase::stopThread(int threadIndex) {
+		if (workers[threadIndex].thread == NULL)
+			return;
+
+		{
+			boost::lock_guard<boost::mutex> lock(poolMutex);
+			workers[threadIndex].exit = true;
+		}
+		workReady.notify_all();
+
+		workers[threadIndex].thread->join();
+		delete workers[threadIndex].thread;
+		workers[threadIndex].thread = NULL;
+	}
+
+	MTBase::~MTBase() {
+		for (int i=1;i<(int)workers.size();i++) {
+			stopThread(i);
+		}
 	}
 
-	template<class io_type> MTBase<io_type>::~MTBase() {
-		while (anyThreadRunning())
-			usleep(10);
+	void MTBase::threadLoop(int threadIndex) {
+		while (true) {
+			{
+				boost::unique_lock<boost::mutex> lock(poolMutex);
 
-		for (int i=0;i<d_nthreads;i++) {
-			if (threads[i]) {
-				delete threads[i];
-				threads[i] = NULL;
+				while (!workers[threadIndex].running && !workers[threadIndex].exit)
+					workReady.wait(lock);
+
+				if (workers[threadIndex].exit)
+					return;
+			}
+
+			runChunks(threadIndex);
+
+			{
+				boost::lock_guard<boost::mutex> lock(poolMutex);
+				workers[threadIndex].running = false;
+				threadsPending--;
+
+				if (threadsPending == 0)
+					workDone.notify_one();
 			}
 		}
 	}
 
-    template<class io_type> bool MTBase<io_type>::anyThreadRunning() {
-    	for (int i=0;i<d_nthreads;i++)
-    		if (threadRunning[i]) {
-    			return true;
-    		}
+	void MTBase::runChunks(int threadIndex) {
+		long chunksRun = 0;
 
-    	return false;
-    }
+		while (true) {
+			long startIndex = nextIndex.fetch_add(runChunkSize,std::memory_order_relaxed);
 
-    template<class io_type> long MTBase<io_type>::calcDecimationBlockSize(long numSamples) {
-    	long decBlockSize;
+			if (startIndex >= runItems)
+				break;
 
-    	long nonDecBlockSize = numSamples / d_nthreads;
+			chunkFunction(chunkContext,startIndex,std::min(runChunkSize,runItems - startIndex),threadIndex);
+			chunksRun++;
+		}
 
-    	long decBlockUnit = nonDecBlockSize / decimation;
+		workers[threadIndex].chunksRun += chunksRun;
+	}
 
-    	decBlockSize = decBlockUnit * decimation;
+	void MTBase::runThreads(long numItems) {
+		if (numItems < 1)
+			return;
 
-    	return decBlockSize;
-    }
+		if (affinityPending)
+			applyAffinity();
 
-    template<class io_type> long MTBase<io_type>::calcDecimationIndex(long blockStartIndex) {
-		// NOTE: calcDecimationIndex assumes the index is an even multiple of a decimation block size
-		// In other words, calcDecimationBlockSize was called to get an appropriate block size,
-		// then blockStartIndex is an integer multiple of that result.
+		long itemsPerChunk;
 
-    	return (blockStartIndex / decimation);
-    }
+		if (chunkSize == LFAST_CHUNK_STATIC)
+			itemsPerChunk = (numItems + d_nthreads - 1) / d_nthreads;
+		else if (chunkSize == LFAST_CHUNK_AUTO)
+			itemsPerChunk = (numItems + d_nthreads*LFAST_CHUNKS_PER_THREAD - 1) / (d_nthreads*LFAST_CHUNKS_PER_THREAD);
+		else
+			itemsPerChunk = chunkSize;
 
-    // ------------------------------------------------
-    // Multi-threaded filter, complex data, float taps
-    // ------------------------------------------------
+		// Don't wake up threads that would have nothing to do.
+		long numChunks = (numItems + itemsPerChunk - 1) / itemsPerChunk;
+		int activeThreads = d_nthreads;
 
-    FIRFilterCCF_MT::FIRFilterCCF_MT(int nthreads):MTBase(nthreads),FIRFilterCCF() {
+		if (numChunks < activeThreads)
+			activeThreads = numChunks;
 
-    }
+		runItems = numItems;
+		runChunkSize = itemsPerChunk;
+		nextIndex.store(0,std::memory_order_relaxed);
 
-    FIRFilterCCF_MT::FIRFilterCCF_MT(const std::vector<float>& newTaps, int nthreads):MTBase(nthreads),FIRFilterCCF(newTaps) {
+		if (activeThreads > 1) {
+			{
+				// The mutex also publishes runItems/runChunkSize/nextIndex to the workers
+				boost::lock_guard<boost::mutex> lock(poolMutex);
+
+				for (int i=1;i<activeThreads;i++)
+					workers[i].running = true;
+
+				threadsPending = activeThreads - 1;
+			}
+			workReady.notify_all();
+		}
 
+		// The calling thread pulls chunks too rather than sitting idle.
+		runChunks(0);
+
+		if (activeThreads > 1) {
+			boost::unique_lock<boost::mutex> lock(poolMutex);
+
+			while (threadsPending > 0)
+				workDone.wait(lock);
+		}
 	}
 
-    FIRFilterCCF_MT::~FIRFilterCCF_MT() {
+	std::vector<long> MTBase::getChunkCounts() {
+		boost::lock_guard<boost::mutex> lock(poolMutex);
 
+		std::vector<long> counts(workers.size());
+
+		for (size_t i=0;i<workers.size();i++)
+			counts[i] = workers[i].chunksRun;
+
+		return counts;
 	}
 
-    void FIRFilterCCF_MT::runThread1(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+	void MTBase::resetChunkCounts() {
+		boost::lock_guard<boost::mutex> lock(poolMutex);
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
+		for (size_t i=0;i<workers.size();i++)
+			workers[i].chunksRun = 0;
+	}
 
-    	threadRunning[0] = false;
-    }
+    bool MTBase::anyThreadRunning() {
+    	boost::lock_guard<boost::mutex> lock(poolMutex);
 
-    void FIRFilterCCF_MT::runThread2(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    	for (int i=1;i<(int)workers.size();i++)
+    		if (workers[i].running) {
+    			return true;
+    		}
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[1] = false;
+    	return false;
     }
 
-    void FIRFilterCCF_MT::runThread3(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    // ------------------------------------------------
+    // Overlap-save FFT filter
+    // ------------------------------------------------
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[2] = false;
+    // Relative cost of one FFT butterfly / spectrum multiply vs. one SIMD dot-product tap
+    #define LFAST_FFT_COST_FACTOR 2.0
+
+    static inline void loadFFTInput(gr_complex *fftInput, const gr_complex *inputBuffer, long count) {
+    	memcpy(fftInput,inputBuffer,count*sizeof(gr_complex));
     }
 
-    void FIRFilterCCF_MT::runThread4(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    static inline void loadFFTInput(gr_complex *fftInput, const float *inputBuffer, long count) {
+    	for (long i=0;i<count;i++)
+    		fftInput[i] = gr_complex(inputBuffer[i],0.0f);
+    }
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
+    static inline void storeFFTOutput(gr_complex *outputBuffer, const gr_complex *result, long count, int stride) {
+    	if (stride == 1) {
+    		memcpy(outputBuffer,result,count*sizeof(gr_complex));
     	}
     	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
+    		for (long i=0;i<count;i++)
+    			outputBuffer[i] = result[i*stride];
     	}
-    	threadRunning[3] = false;
     }
 
-    void FIRFilterCCF_MT::runThread5(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
-
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[4] = false;
+    static inline void storeFFTOutput(float *outputBuffer, const gr_complex *result, long count, int stride) {
+    	for (long i=0;i<count;i++)
+    		outputBuffer[i] = result[i*stride].real();
     }
 
-    void FIRFilterCCF_MT::runThread6(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> FFTFilter<io_type,tap_type>::FFTFilter():Filter<io_type,tap_type>() {
+    	fftSize = 0;
+    	blockLength = 0;
+    	tapsFFT = NULL;
+    	tapsFFTValid = false;
+    	planSize = 0;
+    }
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[5] = false;
+    template<class io_type, class tap_type> FFTFilter<io_type,tap_type>::FFTFilter(const std::vector<tap_type>& newTaps):Filter<io_type,tap_type>(newTaps) {
+    	fftSize = 0;
+    	blockLength = 0;
+    	tapsFFT = NULL;
+    	tapsFFTValid = false;
+    	planSize = 0;
     }
 
-    void FIRFilterCCF_MT::runThread7(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> FFTFilter<io_type,tap_type>::~FFTFilter() {
+    	clearFFTs();
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[6] = false;
+    	if (tapsFFT)
+    		volk_free(tapsFFT);
     }
 
-    void FIRFilterCCF_MT::runThread8(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> void FFTFilter<io_type,tap_type>::setTaps(const std::vector<tap_type>& newTaps) {
+    	Filter<io_type,tap_type>::setTaps(newTaps);
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[7] = false;
+    	// The transform and plans are rebuilt on the next prepare() so callers that never
+    	// use the FFT path don't pay for planning.
+    	tapsFFTValid = false;
     }
 
-    void FIRFilterCCF_MT::runThread9(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> void FFTFilter<io_type,tap_type>::swapTaps(FFTFilter<io_type,tap_type> &other) {
+    	Filter<io_type,tap_type>::swapTaps(other);
+
+    	std::swap(fftSize,other.fftSize);
+    	std::swap(blockLength,other.blockLength);
+    	std::swap(tapsFFT,other.tapsFFT);
+    	std::swap(tapsFFTValid,other.tapsFFTValid);
+    }
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
+    template<class io_type, class tap_type> void FFTFilter<io_type,tap_type>::clearFFTs() {
+    	for (size_t i=0;i<fwdFFTs.size();i++) {
+    		delete fwdFFTs[i];
+    		delete revFFTs[i];
     	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[8] = false;
+
+    	fwdFFTs.clear();
+    	revFFTs.clear();
     }
 
-    void FIRFilterCCF_MT::runThread10(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> int FFTFilter<io_type,tap_type>::fftSizeForTaps(long ntaps) {
+    	int size = 64;
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[9] = false;
+    	while (size < 4*ntaps)
+    		size *= 2;
+
+    	return size;
     }
 
-    void FIRFilterCCF_MT::runThread11(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> bool FFTFilter<io_type,tap_type>::fasterThanDirect(long ntaps, long numOutputs, int decimation) {
+    	if ((ntaps < 1) || (numOutputs < 1))
+    		return false;
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[10] = false;
+    	int size = fftSizeForTaps(ntaps);
+    	long outputsPerBlock = size - ntaps + 1;
+    	long span = (numOutputs - 1) * decimation + 1;
+    	long blocks = (span + outputsPerBlock - 1) / outputsPerBlock;
+
+    	// forward + reverse FFT (size/2 * log2(size) butterflies each) plus the spectrum multiply
+    	double fftCost = (double)blocks * size * (log2((double)size) + 1.0) * LFAST_FFT_COST_FACTOR;
+    	double directCost = (double)numOutputs * ntaps;
+
+    	return fftCost < directCost;
     }
 
-    void FIRFilterCCF_MT::runThread12(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> long FFTFilter<io_type,tap_type>::numBlocks(long numOutputs, int decimation) {
+    	if (numOutputs < 1)
+    		return 0;
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[11] = false;
+    	long outputsPerBlock = fftSizeForTaps(this->numTaps) - this->numTaps + 1;
+    	long span = (numOutputs - 1) * decimation + 1;
+
+    	return (span + outputsPerBlock - 1) / outputsPerBlock;
     }
 
-    void FIRFilterCCF_MT::runThread13(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> void FFTFilter<io_type,tap_type>::buildTapsFFT() {
+    	if (tapsFFT)
+    		volk_free(tapsFFT);
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[12] = false;
+    	fftSize = fftSizeForTaps(this->numTaps);
+    	blockLength = fftSize - this->numTaps + 1;
+    	tapsFFT = (gr_complex *)volk_malloc(fftSize*sizeof(gr_complex),volk_get_alignment());
+
+    	gr::fft::fft_complex_fwd tapTransform(fftSize);
+    	gr_complex *tapInput = tapTransform.get_inbuf();
+    	float scale = 1.0f / (float)fftSize;
+
+    	std::fill_n(tapInput,fftSize,gr_complex(0.0f,0.0f));
+
+    	// d_taps is stored reversed, so undo that for the convolution taps
+    	for (long i=0;i<this->numTaps;i++)
+    		tapInput[i] = gr_complex(this->d_taps[this->numTaps - 1 - i]) * scale;
+
+    	tapTransform.execute();
+    	memcpy(tapsFFT,tapTransform.get_outbuf(),fftSize*sizeof(gr_complex));
+
+    	tapsFFTValid = true;
     }
 
-    void FIRFilterCCF_MT::runThread14(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> void FFTFilter<io_type,tap_type>::prepare(int nthreads) {
+    	if (!tapsFFTValid)
+    		buildTapsFFT();
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
+    	// Plans only need replacing when the tap count moves the FFT size.
+    	if (planSize != fftSize) {
+    		clearFFTs();
+    		planSize = fftSize;
     	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
+
+    	while ((int)fwdFFTs.size() < nthreads) {
+    		fwdFFTs.push_back(new gr::fft::fft_complex_fwd(fftSize));
+    		revFFTs.push_back(new gr::fft::fft_complex_rev(fftSize));
     	}
-    	threadRunning[13] = false;
     }
 
-    void FIRFilterCCF_MT::runThread15(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> void FFTFilter<io_type,tap_type>::filterBlocks(io_type *outputBuffer, const io_type *inputBuffer,
+    		long numOutputs, int decimation, long firstBlock, long blockCount, int workspace) {
+    	gr::fft::fft_complex_fwd *fwd = fwdFFTs[workspace];
+    	gr::fft::fft_complex_rev *rev = revFFTs[workspace];
+    	gr_complex *fftInput = fwd->get_inbuf();
+    	gr_complex *spectrum = fwd->get_outbuf();
+    	gr_complex *revInput = rev->get_inbuf();
+    	gr_complex *result = rev->get_outbuf();
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
+    	long delay = this->numTaps - 1;
+    	long span = (numOutputs - 1) * decimation + 1;
+
+    	for (long b=firstBlock;b<firstBlock+blockCount;b++) {
+    		long blockStart = b * blockLength;
+    		long blockEnd = blockStart + blockLength;
+
+    		if (blockEnd > span)
+    			blockEnd = span;
+
+    		if (blockStart >= blockEnd)
+    			break;
+
+    		// The last block may not have a full FFT's worth of input, zero-fill the rest.
+    		long inputCount = blockEnd - blockStart + delay;
+    		loadFFTInput(fftInput,&inputBuffer[blockStart],inputCount);
+
+    		if (inputCount < fftSize)
+    			std::fill_n(&fftInput[inputCount],fftSize - inputCount,gr_complex(0.0f,0.0f));
+
+    		fwd->execute();
+    		volk_32fc_x2_multiply_32fc(revInput,spectrum,tapsFFT,fftSize);
+    		rev->execute();
+
+    		// The first ntaps-1 results wrap around and are discarded (overlap-save).
+    		long firstPosition = ((blockStart + decimation - 1) / decimation) * decimation;
+
+    		if (firstPosition >= blockEnd)
+    			continue;
+
+    		long count = (blockEnd - 1 - firstPosition) / decimation + 1;
+    		storeFFTOutput(&outputBuffer[firstPosition / decimation],&result[delay + firstPosition - blockStart],count,decimation);
     	}
-    	threadRunning[14] = false;
     }
 
-    void FIRFilterCCF_MT::runThread16(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class tap_type> long FFTFilter<io_type,tap_type>::filterN(io_type *outputBuffer, const io_type *inputBuffer, long numSamples) {
+    	prepare(1);
+    	filterBlocks(outputBuffer,inputBuffer,numSamples,1,0,numBlocks(numSamples,1),0);
 
-        	FIRFilterCCF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-        	FIRFilterCCF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[15] = false;
+    	return numSamples;
     }
 
-	// NOTE: This routine is expecting numSamples to be an integer multiple of the number of taps
-	long FIRFilterCCF_MT::filterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples) {
-		while (anyThreadRunning() || (threadReady == false))
-			usleep(10);
+    template<class io_type, class tap_type> long FFTFilter<io_type,tap_type>::filterNdec(io_type *outputBuffer, const io_type *inputBuffer, long numSamples, int decimation) {
+    	long decimatedCount = numSamples / decimation;
 
-		pInputBuffer = inputBuffer;
-		pOutputBuffer = outputBuffer;
+    	prepare(1);
+    	filterBlocks(outputBuffer,inputBuffer,decimatedCount,decimation,0,numBlocks(decimatedCount,decimation),0);
 
-		long blockSize = numSamples / d_nthreads;
-		long lastBlock = numSamples - (d_nthreads-1)*blockSize;
-		threadReady = false;
+    	return decimatedCount;
+    }
 
-		int curBlock;
+    template class Filter<gr_complex,float>;
+    template class Filter<float,float>;
+    template class Filter<gr_complex,gr_complex>;
 
-		// std::cout << "Starting threads.  numSamples = " << numSamples << " Block size =" << blockSize << " last block=" << lastBlock << std::endl;
+    template class FFTFilter<gr_complex,float>;
+    template class FFTFilter<float,float>;
+    template class FFTFilter<gr_complex,gr_complex>;
 
-		for (int i=0;i<d_nthreads;i++) {
-			threadRunning[i] = true;
+    // ------------------------------------------------
+    // Multi-threaded filter, complex data, float taps
+    // ------------------------------------------------
 
-			if (i<(d_nthreads-1))
-				curBlock = blockSize;
-			else
-				curBlock = lastBlock;
+    FIRFilterCCF_MT::FIRFilterCCF_MT(int nthreads):MTBase(nthreads),FIRFilterCCF() {
+    	engine = LFAST_FILTER_ENGINE_AUTO;
+    }
 
-			switch(i) {
-			case 0:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread1, this,i*blockSize,curBlock));
-				break;
-			case 1:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread2, this,i*blockSize,curBlock));
-				break;
-			case 2:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread3, this,i*blockSize,curBlock));
-				break;
-			case 3:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread4, this,i*blockSize,curBlock));
-				break;
-			case 4:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread5, this,i*blockSize,curBlock));
-				break;
-			case 5:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread6, this,i*blockSize,curBlock));
-				break;
-			case 6:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread7, this,i*blockSize,curBlock));
-				break;
-			case 7:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread8, this,i*blockSize,curBlock));
-				break;
-			case 8:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread9, this,i*blockSize,curBlock));
-				break;
-			case 9:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread10, this,i*blockSize,curBlock));
-				break;
-			case 10:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread11, this,i*blockSize,curBlock));
-				break;
-			case 11:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread12, this,i*blockSize,curBlock));
-				break;
-			case 12:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread13, this,i*blockSize,curBlock));
-				break;
-			case 13:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread14, this,i*blockSize,curBlock));
-				break;
-			case 14:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread15, this,i*blockSize,curBlock));
-				break;
-			case 15:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread16, this,i*blockSize,curBlock));
-				break;
-			}
-		}
+    FIRFilterCCF_MT::FIRFilterCCF_MT(const std::vector<float>& newTaps, int nthreads):MTBase(nthreads),FIRFilterCCF(newTaps) {
+    	engine = LFAST_FILTER_ENGINE_AUTO;
+    	fftFilter.setTaps(newTaps);
+	}
 
-		// std::cout << "Waiting for threads to finish." << std::endl;
-		while (anyThreadRunning())
-			usleep(10);
+    FIRFilterCCF_MT::~FIRFilterCCF_MT() {
 
-		// std::cout << "Threads finished." << std::endl;
-		for (int i=0;i<d_nthreads;i++) {
-			delete threads[i];
-			threads[i] = NULL;
-		}
+	}
 
-		threadReady = true;
+	// NOTE: This routine is expecting numSamples to be an integer multiple of the number of taps
+	long FIRFilterCCF_MT::filterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples) {
+		parallelFor(numSamples,[=](long startIndex, long numItems, int threadIndex) {
+			FIRFilterCCF::filterN(&outputBuffer[startIndex],&inputBuffer[startIndex],numItems);
+		});
 
 		return numSamples;
 	}
 
 	// OutputBuffer here should be at least numSamples/decimation in length
 	long FIRFilterCCF_MT::filterNdec(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation) {
-		// For testing purposes
-		// return FIRFilterCCF::filterNdec(outputBuffer,inputBuffer,numSamples*decimation,decimation);
+		// numSamples passed in here will be the decimated # (noutput_items), so the work is split on output samples.
+		parallelFor(numSamples,[=](long startIndex, long numItems, int threadIndex) {
+			FIRFilterCCF::filterNdec(&outputBuffer[startIndex],&inputBuffer[startIndex*decimation],numItems*decimation,decimation);
+		});
 
-		while (anyThreadRunning() || (threadReady == false))
-			usleep(10);
+		return numSamples;
+	}
 
-		pInputBuffer = inputBuffer;
-		pOutputBuffer = outputBuffer;
+	long FIRFilterCCF_MT::filterNdecPolyphase(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation) {
+		laneBuffers.reserve(d_nthreads);
 
-		// numSamples passed in here will be the decimated # (noutput_items).
-		long inputSamples = numSamples * decimation;
+		parallelFor(numSamples,[=](long startIndex, long numItems, int threadIndex) {
+			long inputSamples = numItems*decimation;
+			gr_complex *lane = laneBuffers.get(threadIndex,polyphaseLaneSize(inputSamples));
 
-		long blockSize = calcDecimationBlockSize(inputSamples);
-		long lastBlock = inputSamples - (d_nthreads-1)*blockSize;
-		//std::cout << "Input Samples: " << inputSamples << " Decimated Block Size: " << blockSize << " last block: " << lastBlock << std::endl;
-		threadReady = false;
+			FIRFilterCCF::filterNdecPolyphase(&outputBuffer[startIndex],&inputBuffer[startIndex*decimation],inputSamples,decimation,lane);
+		});
 
-		long curBlock;
+		return numSamples;
+	}
 
-		// std::cout << "Starting threads.  numSamples = " << numSamples << " Block size =" << blockSize << " last block=" << lastBlock << std::endl;
+	void FIRFilterCCF_MT::setTaps(const std::vector<float>& newTaps) {
+		FIRFilterCCF::setTaps(newTaps);
+		// Applied taps so the FFT engine sees them as LFAST_SYMMETRY_FORCE left them
+		fftFilter.setTaps(getAppliedTaps());
+	}
 
-		for (int i=0;i<d_nthreads;i++) {
-			threadRunning[i] = true;
+	void FIRFilterCCF_MT::swapTaps(FIRFilterCCF_MT &other) {
+		FIRFilterCCF::swapTaps(other);
+		fftFilter.swapTaps(other.fftFilter);
+	}
 
-			if (i<(d_nthreads-1))
-				curBlock = blockSize;
-			else
-				curBlock = lastBlock;
+	void FIRFilterCCF_MT::prepareTaps() {
+		if (engine != LFAST_FILTER_ENGINE_DIRECT)
+			fftFilter.prepare(0);
+	}
 
-			switch(i) {
-			case 0:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread1, this,i*blockSize,curBlock));
-				break;
-			case 1:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread2, this,i*blockSize,curBlock));
-				break;
-			case 2:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread3, this,i*blockSize,curBlock));
-				break;
-			case 3:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread4, this,i*blockSize,curBlock));
-				break;
-			case 4:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread5, this,i*blockSize,curBlock));
-				break;
-			case 5:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread6, this,i*blockSize,curBlock));
-				break;
-			case 6:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread7, this,i*blockSize,curBlock));
-				break;
-			case 7:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread8, this,i*blockSize,curBlock));
-				break;
-			case 8:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread9, this,i*blockSize,curBlock));
-				break;
-			case 9:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread10, this,i*blockSize,curBlock));
-				break;
-			case 10:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread11, this,i*blockSize,curBlock));
-				break;
-			case 11:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread12, this,i*blockSize,curBlock));
-				break;
-			case 12:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread13, this,i*blockSize,curBlock));
-				break;
-			case 13:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread14, this,i*blockSize,curBlock));
-				break;
-			case 14:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread15, this,i*blockSize,curBlock));
-				break;
-			case 15:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCF_MT::runThread16, this,i*blockSize,curBlock));
-				break;
-			}
-		}
+	bool FIRFilterCCF_MT::useFFT(long numSamples, int decimation) {
+		if (engine == LFAST_FILTER_ENGINE_DIRECT)
+			return false;
 
-		// std::cout << "Waiting for threads to finish." << std::endl;
-		while (anyThreadRunning())
-			usleep(10);
+		if (engine == LFAST_FILTER_ENGINE_FFT)
+			return true;
 
-		// std::cout << "Threads finished." << std::endl;
-		for (int i=0;i<d_nthreads;i++) {
-			delete threads[i];
-			threads[i] = NULL;
-		}
+		return FFTFilterCCF::fasterThanDirect(numTaps,numSamples,decimation);
+	}
+
+	long FIRFilterCCF_MT::filterNFFT(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation) {
+		fftFilter.prepare(d_nthreads);
 
-		threadReady = true;
+		// Whole FFT blocks are handed out to the threads, each thread using its own FFT plans.
+		parallelFor(fftFilter.numBlocks(numSamples,decimation),[=](long startIndex, long numItems, int threadIndex) {
+			fftFilter.filterBlocks(outputBuffer,inputBuffer,numSamples,decimation,startIndex,numItems,threadIndex);
+		});
 
 		return numSamples;
 	}
@@ -750,787 +1279,806 @@ namespace gr {
     // ------------------------------------------------
 
     FIRFilterFFF_MT::FIRFilterFFF_MT(int nthreads):MTBase(nthreads),FIRFilterFFF() {
-
+    	engine = LFAST_FILTER_ENGINE_AUTO;
     }
 
     FIRFilterFFF_MT::FIRFilterFFF_MT(const std::vector<float>& newTaps, int nthreads):MTBase(nthreads),FIRFilterFFF(newTaps) {
-
+    	engine = LFAST_FILTER_ENGINE_AUTO;
+    	fftFilter.setTaps(newTaps);
 	}
 
     FIRFilterFFF_MT::~FIRFilterFFF_MT() {
 
 	}
 
-    void FIRFilterFFF_MT::runThread1(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+	// NOTE: This routine is expecting numSamples to be an integer multiple of the number of taps
+	long FIRFilterFFF_MT::filterN(float *outputBuffer, const float *inputBuffer, long numSamples) {
+		parallelFor(numSamples,[=](long startIndex, long numItems, int threadIndex) {
+			FIRFilterFFF::filterN(&outputBuffer[startIndex],&inputBuffer[startIndex],numItems);
+		});
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[0] = false;
-    }
+		return numSamples;
+	}
 
-    void FIRFilterFFF_MT::runThread2(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+	// OutputBuffer here should be at least numSamples/decimation in length
+	long FIRFilterFFF_MT::filterNdec(float *outputBuffer, const float *inputBuffer, long numSamples, int decimation) {
+		parallelFor(numSamples,[=](long startIndex, long numItems, int threadIndex) {
+			FIRFilterFFF::filterNdec(&outputBuffer[startIndex],&inputBuffer[startIndex*decimation],numItems*decimation,decimation);
+		});
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[1] = false;
+		return numSamples;
+	}
+
+	long FIRFilterFFF_MT::filterNdecPolyphase(float *outputBuffer, const float *inputBuffer, long numSamples, int decimation) {
+		laneBuffers.reserve(d_nthreads);
+
+		parallelFor(numSamples,[=](long startIndex, long numItems, int threadIndex) {
+			long inputSamples = numItems*decimation;
+			float *lane = laneBuffers.get(threadIndex,polyphaseLaneSize(inputSamples));
+
+			FIRFilterFFF::filterNdecPolyphase(&outputBuffer[startIndex],&inputBuffer[startIndex*decimation],inputSamples,decimation,lane);
+		});
+
+		return numSamples;
+	}
+
+	void FIRFilterFFF_MT::setTaps(const std::vector<float>& newTaps) {
+		FIRFilterFFF::setTaps(newTaps);
+		// Applied taps so the FFT engine sees them as LFAST_SYMMETRY_FORCE left them
+		fftFilter.setTaps(getAppliedTaps());
+	}
+
+	void FIRFilterFFF_MT::swapTaps(FIRFilterFFF_MT &other) {
+		FIRFilterFFF::swapTaps(other);
+		fftFilter.swapTaps(other.fftFilter);
+	}
+
+	void FIRFilterFFF_MT::prepareTaps() {
+		if (engine != LFAST_FILTER_ENGINE_DIRECT)
+			fftFilter.prepare(0);
+	}
+
+	bool FIRFilterFFF_MT::useFFT(long numSamples, int decimation) {
+		if (engine == LFAST_FILTER_ENGINE_DIRECT)
+			return false;
+
+		if (engine == LFAST_FILTER_ENGINE_FFT)
+			return true;
+
+		return FFTFilterFFF::fasterThanDirect(numTaps,numSamples,decimation);
+	}
+
+	long FIRFilterFFF_MT::filterNFFT(float *outputBuffer, const float *inputBuffer, long numSamples, int decimation) {
+		fftFilter.prepare(d_nthreads);
+
+		// Whole FFT blocks are handed out to the threads, each thread using its own FFT plans.
+		parallelFor(fftFilter.numBlocks(numSamples,decimation),[=](long startIndex, long numItems, int threadIndex) {
+			fftFilter.filterBlocks(outputBuffer,inputBuffer,numSamples,decimation,startIndex,numItems,threadIndex);
+		});
+
+		return numSamples;
+	}
+
+    // ------------------------------------------------
+    // Multi-threaded filter, complex data, complex taps
+    // ------------------------------------------------
+
+    FIRFilterCCC_MT::FIRFilterCCC_MT(int nthreads):MTBase(nthreads),FIRFilterCCC() {
+    	engine = LFAST_FILTER_ENGINE_AUTO;
     }
 
-    void FIRFilterFFF_MT::runThread3(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    FIRFilterCCC_MT::FIRFilterCCC_MT(const std::vector<gr_complex>& newTaps, int nthreads):MTBase(nthreads),FIRFilterCCC(newTaps) {
+    	engine = LFAST_FILTER_ENGINE_AUTO;
+    	fftFilter.setTaps(newTaps);
+	}
+
+    FIRFilterCCC_MT::~FIRFilterCCC_MT() {
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[2] = false;
+	}
+
+	// NOTE: This routine is expecting numSamples to be an integer multiple of the number of taps
+	long FIRFilterCCC_MT::filterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples) {
+		parallelFor(numSamples,[=](long startIndex, long numItems, int threadIndex) {
+			FIRFilterCCC::filterN(&outputBuffer[startIndex],&inputBuffer[startIndex],numItems);
+		});
+
+		return numSamples;
+	}
+
+	// OutputBuffer here should be at least numSamples/decimation in length
+	long FIRFilterCCC_MT::filterNdec(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation) {
+		parallelFor(numSamples,[=](long startIndex, long numItems, int threadIndex) {
+			FIRFilterCCC::filterNdec(&outputBuffer[startIndex],&inputBuffer[startIndex*decimation],numItems*decimation,decimation);
+		});
+
+		return numSamples;
+	}
+
+	long FIRFilterCCC_MT::filterNdecPolyphase(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation) {
+		laneBuffers.reserve(d_nthreads);
+
+		parallelFor(numSamples,[=](long startIndex, long numItems, int threadIndex) {
+			long inputSamples = numItems*decimation;
+			gr_complex *lane = laneBuffers.get(threadIndex,polyphaseLaneSize(inputSamples));
+
+			FIRFilterCCC::filterNdecPolyphase(&outputBuffer[startIndex],&inputBuffer[startIndex*decimation],inputSamples,decimation,lane);
+		});
+
+		return numSamples;
+	}
+
+	void FIRFilterCCC_MT::setTaps(const std::vector<gr_complex>& newTaps) {
+		FIRFilterCCC::setTaps(newTaps);
+		// Applied taps so the FFT engine sees them as LFAST_SYMMETRY_FORCE left them
+		fftFilter.setTaps(getAppliedTaps());
+	}
+
+	void FIRFilterCCC_MT::swapTaps(FIRFilterCCC_MT &other) {
+		FIRFilterCCC::swapTaps(other);
+		fftFilter.swapTaps(other.fftFilter);
+	}
+
+	void FIRFilterCCC_MT::prepareTaps() {
+		if (engine != LFAST_FILTER_ENGINE_DIRECT)
+			fftFilter.prepare(0);
+	}
+
+	bool FIRFilterCCC_MT::useFFT(long numSamples, int decimation) {
+		if (engine == LFAST_FILTER_ENGINE_DIRECT)
+			return false;
+
+		if (engine == LFAST_FILTER_ENGINE_FFT)
+			return true;
+
+		return FFTFilterCCC::fasterThanDirect(numTaps,numSamples,decimation);
+	}
+
+	long FIRFilterCCC_MT::filterNFFT(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation) {
+		fftFilter.prepare(d_nthreads);
+
+		// Whole FFT blocks are handed out to the threads, each thread using its own FFT plans.
+		parallelFor(fftFilter.numBlocks(numSamples,decimation),[=](long startIndex, long numItems, int threadIndex) {
+			fftFilter.filterBlocks(outputBuffer,inputBuffer,numSamples,decimation,startIndex,numItems,threadIndex);
+		});
+
+		return numSamples;
+	}
+
+    // ------------------------------------------------
+    // Complex int16 filter, int16 taps
+    // ------------------------------------------------
+    static inline int32_t packPair(int16_t low, int16_t high) {
+    	return (int32_t)((uint32_t)(uint16_t)low | ((uint32_t)(uint16_t)high << 16));
     }
 
-    void FIRFilterFFF_MT::runThread4(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    // Scalar version of one pmaddwd lane.  Unsigned so it wraps the same way the SIMD version does.
+    static inline uint32_t pairMultiplyAdd(int32_t pair, int32_t tapPair) {
+    	return (uint32_t)((int32_t)(int16_t)(pair & 0xffff) * (int32_t)(int16_t)(tapPair & 0xffff)) +
+    			(uint32_t)((int32_t)(int16_t)(pair >> 16) * (int32_t)(int16_t)(tapPair >> 16));
+    }
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[3] = false;
+    FIRFilterSCS::FIRFilterSCS() {
+    	numTaps = 0;
+    	outputShift = 15;
+    	floatScale = 1.0f / (32768.0f * 32768.0f);
+    	phaseDecimation = 1;
+    	maxPhaseLength = 0;
     }
 
-    void FIRFilterFFF_MT::runThread5(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    FIRFilterSCS::FIRFilterSCS(const std::vector<int16_t>& newTaps) {
+    	numTaps = 0;
+    	outputShift = 15;
+    	floatScale = 1.0f / (32768.0f * 32768.0f);
+    	phaseDecimation = 1;
+    	maxPhaseLength = 0;
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[4] = false;
+    	setTaps(newTaps);
     }
 
-    void FIRFilterFFF_MT::runThread6(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    void FIRFilterSCS::setTaps(const std::vector<int16_t>& newTaps) {
+		d_taps = newTaps;
+		std::reverse(d_taps.begin(), d_taps.end());
+
+		numTaps = d_taps.size();
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[5] = false;
+		buildPhases();
     }
 
-    void FIRFilterFFF_MT::runThread7(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    std::vector<int16_t> FIRFilterSCS::getTaps() const {
+	    std::vector<int16_t> revTaps = d_taps;
+		std::reverse(revTaps.begin(), revTaps.end());
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[6] = false;
+		return revTaps;
     }
 
-    void FIRFilterFFF_MT::runThread8(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    void FIRFilterSCS::setDecimation(int decimation) {
+    	if (decimation < 1)
+    		decimation = 1;
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[7] = false;
+    	phaseDecimation = decimation;
+
+    	buildPhases();
     }
 
-    void FIRFilterFFF_MT::runThread9(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    void FIRFilterSCS::buildPhases() {
+    	phaseTapPairs.assign(phaseDecimation,std::vector<int32_t>());
+    	phaseLength.assign(phaseDecimation,0);
+    	maxPhaseLength = 0;
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
+    	// Phase p applies reversed taps p, p+D, p+2D, ... to input samples p, p+D, p+2D, ...
+    	for (int p=0;p<phaseDecimation;p++) {
+    		std::vector<int16_t> phaseTaps;
+
+    		for (long i=p;i<numTaps;i+=phaseDecimation)
+    			phaseTaps.push_back(d_taps[i]);
+
+    		phaseLength[p] = phaseTaps.size();
+    		maxPhaseLength = std::max(maxPhaseLength,phaseLength[p]);
+
+    		// Odd lengths get a zero tap to complete the last pair
+    		if (phaseTaps.size() & 1)
+    			phaseTaps.push_back(0);
+
+    		for (size_t i=0;i<phaseTaps.size();i+=2)
+    			phaseTapPairs[p].push_back(packPair(phaseTaps[i],phaseTaps[i+1]));
     	}
-    	threadRunning[8] = false;
     }
 
-    void FIRFilterFFF_MT::runThread10(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    void FIRFilterSCS::accumulate(int32_t *accI, int32_t *accQ, const lv_16sc_t *inputBuffer, long numOutputs,
+    		int32_t *pairsI, int32_t *pairsQ) {
+    	const int16_t *samples = (const int16_t *)inputBuffer;
+    	long stride = 2*phaseDecimation;
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
+    	std::fill_n(accI,numOutputs,0);
+    	std::fill_n(accQ,numOutputs,0);
+
+    	for (int p=0;p<phaseDecimation;p++) {
+    		if (phaseLength[p] == 0)
+    			continue;
+
+    		long numPairs = phaseTapPairs[p].size();
+    		const int32_t *tapPairs = &phaseTapPairs[p][0];
+    		long laneLength = numOutputs + phaseLength[p] - 1;
+    		long pairLength = numOutputs + 2*numPairs - 2;
+
+    		// pairs[m] = (lane[m], lane[m+1]).  Past the end of the lane only meets the zero pad tap.
+    		const int16_t *in = &samples[2*p];
+
+    		for (long m=0;m<pairLength;m++) {
+    			int16_t nextI = 0;
+    			int16_t nextQ = 0;
+
+    			if (m + 1 < laneLength) {
+    				nextI = in[stride];
+    				nextQ = in[stride+1];
+    			}
+
+    			pairsI[m] = packPair(in[0],nextI);
+    			pairsQ[m] = packPair(in[1],nextQ);
+    			in += stride;
+    		}
+
+    		long n = blockedAccumulateS16(accI,accQ,pairsI,pairsQ,tapPairs,numPairs,numOutputs);
+
+    		for (;n<numOutputs;n++) {
+    			uint32_t sumI = (uint32_t)accI[n];
+    			uint32_t sumQ = (uint32_t)accQ[n];
+
+    			for (long j=0;j<numPairs;j++) {
+    				sumI += pairMultiplyAdd(pairsI[n+2*j],tapPairs[j]);
+    				sumQ += pairMultiplyAdd(pairsQ[n+2*j],tapPairs[j]);
+    			}
+
+    			accI[n] = (int32_t)sumI;
+    			accQ[n] = (int32_t)sumQ;
+    		}
     	}
-    	threadRunning[9] = false;
     }
 
-    void FIRFilterFFF_MT::runThread11(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    int32_t *FIRFilterSCS::getWorkspace(int32_t *workspace, long numOutputs) {
+    	if (workspace)
+    		return workspace;
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[10] = false;
+    	workspaces.reserve(1);
+
+    	return workspaces.get(0,workspaceSize(numOutputs));
     }
 
-    void FIRFilterFFF_MT::runThread12(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    long FIRFilterSCS::filterNdec(lv_16sc_t *outputBuffer, const lv_16sc_t *inputBuffer, long numOutputs, int decimation, int32_t *workspace) {
+    	if (decimation != phaseDecimation)
+    		setDecimation(decimation);
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
+    	int32_t *accI = getWorkspace(workspace,numOutputs);
+    	int32_t *accQ = accI + numOutputs;
+    	int32_t *pairsI = accQ + numOutputs;
+    	int32_t *pairsQ = pairsI + numOutputs + maxPhaseLength + 1;
+
+    	accumulate(accI,accQ,inputBuffer,numOutputs,pairsI,pairsQ);
+
+    	int64_t rounding = (outputShift > 0) ? ((int64_t)1 << (outputShift - 1)) : 0;
+    	int16_t *out = (int16_t *)outputBuffer;
+
+    	for (long i=0;i<numOutputs;i++) {
+    		int64_t valueI = ((int64_t)accI[i] + rounding) >> outputShift;
+    		int64_t valueQ = ((int64_t)accQ[i] + rounding) >> outputShift;
+
+    		out[2*i] = (int16_t)std::max((int64_t)-32768,std::min((int64_t)32767,valueI));
+    		out[2*i+1] = (int16_t)std::max((int64_t)-32768,std::min((int64_t)32767,valueQ));
     	}
-    	threadRunning[11] = false;
+
+    	return numOutputs;
     }
 
-    void FIRFilterFFF_MT::runThread13(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    long FIRFilterSCS::filterNdec(gr_complex *outputBuffer, const lv_16sc_t *inputBuffer, long numOutputs, int decimation, int32_t *workspace) {
+    	if (decimation != phaseDecimation)
+    		setDecimation(decimation);
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
+    	int32_t *accI = getWorkspace(workspace,numOutputs);
+    	int32_t *accQ = accI + numOutputs;
+    	int32_t *pairsI = accQ + numOutputs;
+    	int32_t *pairsQ = pairsI + numOutputs + maxPhaseLength + 1;
+
+    	accumulate(accI,accQ,inputBuffer,numOutputs,pairsI,pairsQ);
+
+    	float *out = (float *)outputBuffer;
+
+    	for (long i=0;i<numOutputs;i++) {
+    		out[2*i] = (float)accI[i] * floatScale;
+    		out[2*i+1] = (float)accQ[i] * floatScale;
     	}
-    	threadRunning[12] = false;
+
+    	return numOutputs;
     }
 
-    void FIRFilterFFF_MT::runThread14(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    FIRFilterSCS_MT::FIRFilterSCS_MT(int nthreads):MTBase(nthreads),FIRFilterSCS() {
+    }
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[13] = false;
+    FIRFilterSCS_MT::FIRFilterSCS_MT(const std::vector<int16_t>& newTaps, int nthreads):MTBase(nthreads),FIRFilterSCS(newTaps) {
     }
 
-    void FIRFilterFFF_MT::runThread15(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    long FIRFilterSCS_MT::filterNdec(lv_16sc_t *outputBuffer, const lv_16sc_t *inputBuffer, long numOutputs, int decimation, int32_t *workspace) {
+    	if (decimation != phaseDecimation)
+    		setDecimation(decimation);
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[14] = false;
+    	workspaces.reserve(d_nthreads);
+
+    	parallelFor(numOutputs,[=](long startIndex, long numItems, int threadIndex) {
+    		int32_t *threadWorkspace = workspaces.get(threadIndex,workspaceSize(numItems));
+
+    		FIRFilterSCS::filterNdec(&outputBuffer[startIndex],&inputBuffer[startIndex*decimation],numItems,decimation,threadWorkspace);
+    	});
+
+    	return numOutputs;
     }
 
-    void FIRFilterFFF_MT::runThread16(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    long FIRFilterSCS_MT::filterNdec(gr_complex *outputBuffer, const lv_16sc_t *inputBuffer, long numOutputs, int decimation, int32_t *workspace) {
+    	if (decimation != phaseDecimation)
+    		setDecimation(decimation);
 
-    		FIRFilterFFF::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterFFF::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[15] = false;
+    	workspaces.reserve(d_nthreads);
+
+    	parallelFor(numOutputs,[=](long startIndex, long numItems, int threadIndex) {
+    		int32_t *threadWorkspace = workspaces.get(threadIndex,workspaceSize(numItems));
+
+    		FIRFilterSCS::filterNdec(&outputBuffer[startIndex],&inputBuffer[startIndex*decimation],numItems,decimation,threadWorkspace);
+    	});
+
+    	return numOutputs;
     }
 
+    // ------------------------------------------------
+    // Multi-threaded polyphase interpolator / rational resampler
+    // ------------------------------------------------
 
-	// NOTE: This routine is expecting numSamples to be an integer multiple of the number of taps
-	long FIRFilterFFF_MT::filterN(float *outputBuffer, const float *inputBuffer, long numSamples) {
-		while (anyThreadRunning() || (threadReady == false))
-			usleep(10);
+    template<class io_type, class tap_type> PolyphaseResampler<io_type,tap_type>::PolyphaseResampler(int interpolation, int decimation,
+    		const std::vector<tap_type>& newTaps, int nthreads):MTBase(nthreads) {
+    	if (interpolation < 1)
+    		interpolation = 1;
 
-		pInputBuffer = inputBuffer;
-		pOutputBuffer = outputBuffer;
+    	if (decimation < 1)
+    		decimation = 1;
 
-		long blockSize = numSamples / d_nthreads;
-		long lastBlock = numSamples - (d_nthreads-1)*blockSize;
-		threadReady = false;
+    	d_interpolation = interpolation;
+    	d_decimation = decimation;
+    	subFilterLength = 0;
 
-		int curBlock;
+    	setTaps(newTaps);
+    }
 
-		// std::cout << "Starting threads.  noutput_items = " << noutput_items << " Block size =" << blockSize << " last block=" << lastBlock << std::endl;
+    template<class io_type, class tap_type> PolyphaseResampler<io_type,tap_type>::~PolyphaseResampler() {
+    	clearSubFilters();
+    }
 
-		for (int i=0;i<d_nthreads;i++) {
-			threadRunning[i] = true;
+    template<class io_type, class tap_type> void PolyphaseResampler<io_type,tap_type>::clearSubFilters() {
+    	for (size_t i=0;i<subFilters.size();i++) {
+    		delete subFilters[i];
+    	}
 
-			if (i<(d_nthreads-1))
-				curBlock = blockSize;
-			else
-				curBlock = lastBlock;
+    	subFilters.clear();
+    }
 
-			switch(i) {
-			case 0:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread1, this,i*blockSize,curBlock));
-				break;
-			case 1:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread2, this,i*blockSize,curBlock));
-				break;
-			case 2:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread3, this,i*blockSize,curBlock));
-				break;
-			case 3:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread4, this,i*blockSize,curBlock));
-				break;
-			case 4:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread5, this,i*blockSize,curBlock));
-				break;
-			case 5:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread6, this,i*blockSize,curBlock));
-				break;
-			case 6:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread7, this,i*blockSize,curBlock));
-				break;
-			case 7:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread8, this,i*blockSize,curBlock));
-				break;
-			case 8:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread9, this,i*blockSize,curBlock));
-				break;
-			case 9:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread10, this,i*blockSize,curBlock));
-				break;
-			case 10:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread11, this,i*blockSize,curBlock));
-				break;
-			case 11:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread12, this,i*blockSize,curBlock));
-				break;
-			case 12:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread13, this,i*blockSize,curBlock));
-				break;
-			case 13:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread14, this,i*blockSize,curBlock));
-				break;
-			case 14:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread15, this,i*blockSize,curBlock));
-				break;
-			case 15:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread16, this,i*blockSize,curBlock));
-				break;
-			}
-		}
+    template<class io_type, class tap_type> void PolyphaseResampler<io_type,tap_type>::setTaps(const std::vector<tap_type>& newTaps) {
+    	clearSubFilters();
 
-		// std::cout << "Waiting for threads to finish." << std::endl;
-		while (anyThreadRunning())
-			usleep(10);
+    	d_prototypeTaps = newTaps;
 
-		// std::cout << "Threads finished." << std::endl;
-		for (int i=0;i<d_nthreads;i++) {
-			delete threads[i];
-			threads[i] = NULL;
-		}
+    	// Pad the prototype out to an integer multiple of the interpolation so every sub-filter is the same length.
+    	subFilterLength = (newTaps.size() + d_interpolation - 1) / d_interpolation;
 
-		threadReady = true;
-		return numSamples;
-	}
+    	if (subFilterLength < 1)
+    		subFilterLength = 1;
 
-	// OutputBuffer here should be at least numSamples/decimation in length
-	long FIRFilterFFF_MT::filterNdec(float *outputBuffer, const float *inputBuffer, long numSamples, int decimation) {
-		while (anyThreadRunning() || (threadReady == false))
-			usleep(10);
+    	for (int k=0;k<d_interpolation;k++) {
+    		std::vector<tap_type> subTaps(subFilterLength,tap_type(0));
 
-		pInputBuffer = inputBuffer;
-		pOutputBuffer = outputBuffer;
+    		for (long j=0;j<subFilterLength;j++) {
+    			size_t tapIndex = k + j*d_interpolation;
 
-		numSamples = numSamples * decimation;
-		long blockSize = calcDecimationBlockSize(numSamples);
+    			if (tapIndex < newTaps.size())
+    				subTaps[j] = newTaps[tapIndex];
+    		}
 
-		long lastBlock = numSamples - (d_nthreads-1)*blockSize;
-		threadReady = false;
+    		// Filter reverses and aligns the sub-filter taps for us.
+    		subFilters.push_back(new Filter<io_type,tap_type>(subTaps));
+    	}
+    }
 
-		int curBlock;
+    template<class io_type, class tap_type> long PolyphaseResampler<io_type,tap_type>::outputsAvailable(long numInputs, long phaseCounter) {
+    	// The last output's input index, (phaseCounter + (n-1)*D) / I, has to be < numInputs.
+    	long lastPosition = numInputs * d_interpolation - 1 - phaseCounter;
 
-		// std::cout << "Starting threads.  numSamples = " << numSamples << " Block size =" << blockSize << " last block=" << lastBlock << std::endl;
+    	if (lastPosition < 0)
+    		return 0;
 
-		for (int i=0;i<d_nthreads;i++) {
-			threadRunning[i] = true;
+    	return lastPosition / d_decimation + 1;
+    }
 
-			if (i<(d_nthreads-1))
-				curBlock = blockSize;
-			else
-				curBlock = lastBlock;
+    template<class io_type, class tap_type> long PolyphaseResampler<io_type,tap_type>::filterN(io_type *outputBuffer, const io_type *inputBuffer,
+    		long numOutputs, long phaseCounter) {
+    	parallelFor(numOutputs,[=](long startIndex, long numItems, int threadIndex) {
+    		long position = phaseCounter + startIndex * d_decimation;
+    		long inputIndex = position / d_interpolation;
+    		long phase = position % d_interpolation;
+    		io_type *out = &outputBuffer[startIndex];
 
-			switch(i) {
-			case 0:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread1, this,i*blockSize,curBlock));
-				break;
-			case 1:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread2, this,i*blockSize,curBlock));
-				break;
-			case 2:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread3, this,i*blockSize,curBlock));
-				break;
-			case 3:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread4, this,i*blockSize,curBlock));
-				break;
-			case 4:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread5, this,i*blockSize,curBlock));
-				break;
-			case 5:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread6, this,i*blockSize,curBlock));
-				break;
-			case 6:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread7, this,i*blockSize,curBlock));
-				break;
-			case 7:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread8, this,i*blockSize,curBlock));
-				break;
-			case 8:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread9, this,i*blockSize,curBlock));
-				break;
-			case 9:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread10, this,i*blockSize,curBlock));
-				break;
-			case 10:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread11, this,i*blockSize,curBlock));
-				break;
-			case 11:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread12, this,i*blockSize,curBlock));
-				break;
-			case 12:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread13, this,i*blockSize,curBlock));
-				break;
-			case 13:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread14, this,i*blockSize,curBlock));
-				break;
-			case 14:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread15, this,i*blockSize,curBlock));
-				break;
-			case 15:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterFFF_MT::runThread16, this,i*blockSize,curBlock));
-				break;
-			}
-		}
+    		for (long i=0;i<numItems;i++) {
+    			subFilters[phase]->alignedDotProd(out++,&inputBuffer[inputIndex]);
 
-		// std::cout << "Waiting for threads to finish." << std::endl;
-		while (anyThreadRunning())
-			usleep(10);
+    			phase += d_decimation;
 
-		// std::cout << "Threads finished." << std::endl;
-		for (int i=0;i<d_nthreads;i++) {
-			delete threads[i];
-			threads[i] = NULL;
-		}
+    			while (phase >= d_interpolation) {
+    				phase -= d_interpolation;
+    				inputIndex++;
+    			}
+    		}
+    	});
 
-		threadReady = true;
+    	return numOutputs;
+    }
 
-		return numSamples;
-	}
+    template class PolyphaseResampler<gr_complex,float>;
+    template class PolyphaseResampler<float,float>;
+    template class PolyphaseResampler<gr_complex,gr_complex>;
 
     // ------------------------------------------------
-    // Multi-threaded filter, complex data, float taps
+    // Half-band decimator
     // ------------------------------------------------
+    template<class io_type, class lane_filter_type> HalfBandDecimator<io_type,lane_filter_type>::HalfBandDecimator(const std::vector<float>& newTaps,
+    		int stages, int nthreads):MTBase(nthreads) {
+    	if (stages < 1)
+    		stages = 1;
 
-    FIRFilterCCC_MT::FIRFilterCCC_MT(int nthreads):MTBase(nthreads),FIRFilterCCC() {
+    	numStages = stages;
+    	numTaps = 0;
 
+    	setTaps(newTaps);
     }
 
-    FIRFilterCCC_MT::FIRFilterCCC_MT(const std::vector<gr_complex>& newTaps, int nthreads):MTBase(nthreads),FIRFilterCCC(newTaps) {
+    template<class io_type, class lane_filter_type> bool HalfBandDecimator<io_type,lane_filter_type>::isHalfBand(const std::vector<float>& taps) {
+    	long length = taps.size();
 
-	}
+    	if ((length < 3) || ((length & 1) == 0))
+    		return false;
 
-    FIRFilterCCC_MT::~FIRFilterCCC_MT() {
+    	float maxTap = 0.0;
 
-	}
+    	for (long i=0;i<length;i++)
+    		maxTap = std::max(maxTap,std::abs(taps[i]));
 
-    void FIRFilterCCC_MT::runThread1(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    	long center = (length - 1) / 2;
+    	float tolerance = 1e-6 * maxTap;
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
+    	for (long offset=2;offset<=center;offset+=2) {
+    		if ((std::abs(taps[center-offset]) > tolerance) || (std::abs(taps[center+offset]) > tolerance))
+    			return false;
     	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[0] = false;
+
+    	return true;
     }
 
-    void FIRFilterCCC_MT::runThread2(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class lane_filter_type> void HalfBandDecimator<io_type,lane_filter_type>::setTaps(const std::vector<float>& newTaps) {
+    	if (!isHalfBand(newTaps))
+    		throw std::invalid_argument("HalfBandDecimator: taps must be odd-length half-band taps (every second tap from the center is 0)");
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[1] = false;
-    }
+    	d_taps = newTaps;
+    	numTaps = d_taps.size();
 
-    void FIRFilterCCC_MT::runThread3(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    	std::vector<float> revTaps = d_taps;
+    	std::reverse(revTaps.begin(), revTaps.end());
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[2] = false;
-    }
+    	centerIndex = (numTaps - 1) / 2;
+    	centerTap = revTaps[centerIndex];
 
-    void FIRFilterCCC_MT::runThread4(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    	// Every other tap from the center is 0, so the rest sit on the opposite phase from the center.
+    	lanePhase = (centerIndex + 1) & 1;
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[3] = false;
-    }
+    	std::vector<float> laneRevTaps;
 
-    void FIRFilterCCC_MT::runThread5(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    	for (long i=lanePhase;i<numTaps;i+=2)
+    		laneRevTaps.push_back(revTaps[i]);
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[4] = false;
+    	laneTaps = laneRevTaps.size();
+
+    	// setTaps takes the taps in filter order and reverses them itself
+    	std::reverse(laneRevTaps.begin(), laneRevTaps.end());
+    	laneFilter.setTaps(laneRevTaps);
     }
 
-    void FIRFilterCCC_MT::runThread6(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class lane_filter_type> void HalfBandDecimator<io_type,lane_filter_type>::filterStage(io_type *outputBuffer,
+    		const io_type *inputBuffer, long numOutputs, io_type *lane) {
+    	long laneLength = numOutputs + laneTaps - 1;
+    	const io_type *in = &inputBuffer[lanePhase];
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
+    	for (long i=0;i<laneLength;i++) {
+    		lane[i] = *in;
+    		in += 2;
     	}
-    	threadRunning[5] = false;
-    }
 
-    void FIRFilterCCC_MT::runThread7(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    	laneFilter.filterN(outputBuffer,lane,numOutputs);
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
+    	in = &inputBuffer[centerIndex];
+
+    	for (long i=0;i<numOutputs;i++) {
+    		outputBuffer[i] += *in * centerTap;
+    		in += 2;
     	}
-    	threadRunning[6] = false;
     }
 
-    void FIRFilterCCC_MT::runThread8(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template<class io_type, class lane_filter_type> long HalfBandDecimator<io_type,lane_filter_type>::filterN(io_type *outputBuffer,
+    		const io_type *inputBuffer, long numOutputs) {
+    	laneBuffers.reserve(d_nthreads);
+    	stageBuffers[0].reserve(d_nthreads);
+    	stageBuffers[1].reserve(d_nthreads);
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[7] = false;
-    }
+    	parallelFor(numOutputs,[=](long startIndex, long numItems, int threadIndex) {
+    		const io_type *in = &inputBuffer[startIndex * decimation()];
+    		// Stage 0 produces the most outputs, so its lane is the largest any stage needs
+    		long firstStageOutputs = (numItems << (numStages - 1)) + (numTaps - 2) * ((1L << (numStages - 1)) - 1);
+    		io_type *lane = laneBuffers.get(threadIndex,firstStageOutputs + laneTaps);
 
-    void FIRFilterCCC_MT::runThread9(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    		for (int stage=0;stage<numStages;stage++) {
+    			// Outputs this stage needs to feed the remaining stages
+    			long remaining = numStages - 1 - stage;
+    			long stageOutputs = (numItems << remaining) + (numTaps - 2) * ((1L << remaining) - 1);
+    			io_type *out;
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[8] = false;
-    }
+    			if (stage == numStages - 1)
+    				out = &outputBuffer[startIndex];
+    			else
+    				out = stageBuffers[stage & 1].get(threadIndex,stageOutputs);
 
-    void FIRFilterCCC_MT::runThread10(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    			filterStage(out,in,stageOutputs,lane);
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[9] = false;
+    			in = out;
+    		}
+    	});
+
+    	return numOutputs;
     }
 
-    void FIRFilterCCC_MT::runThread11(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    template class HalfBandDecimator<gr_complex,FIRFilterCCF>;
+    template class HalfBandDecimator<float,FIRFilterFFF>;
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[10] = false;
+    // ------------------------------------------------
+    // Fused filter chain
+    // ------------------------------------------------
+    FilterChainCCF::FilterChainCCF(int nthreads):MTBase(nthreads) {
+    	numTileStages = 0;
+    	totalDecimation = 1;
+    	history = 0;
+    	tileSize = 0;
     }
 
-    void FIRFilterCCC_MT::runThread12(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
-
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
+    FilterChainCCF::~FilterChainCCF() {
+    	for (size_t i=0;i<stages.size();i++) {
+    		if (stages[i].fir)
+    			delete stages[i].fir;
     	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[11] = false;
     }
 
-    void FIRFilterCCC_MT::runThread13(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    void FilterChainCCF::addFIR(const std::vector<float>& taps, int decimation) {
+    	if (numTileStages < (int)stages.size())
+    		throw std::invalid_argument("FilterChainCCF: FIR stages must come before any AGC stage");
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[12] = false;
-    }
+    	if ((decimation < 1) || taps.empty())
+    		throw std::invalid_argument("FilterChainCCF: FIR stages need taps and a decimation > 0");
 
-    void FIRFilterCCC_MT::runThread14(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    	ChainStage stage = ChainStage();
+    	stage.type = LFAST_CHAIN_FIR;
+    	stage.fir = new FIRFilterCCF(taps);
+    	stage.decimation = decimation;
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[13] = false;
+    	stages.push_back(stage);
+    	numTileStages++;
+
+    	updateGeometry();
     }
 
-    void FIRFilterCCC_MT::runThread15(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    void FilterChainCCF::addRotator(double phaseIncrement) {
+    	if (numTileStages < (int)stages.size())
+    		throw std::invalid_argument("FilterChainCCF: rotator stages must come before any AGC stage");
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[14] = false;
+    	ChainStage stage = ChainStage();
+    	stage.type = LFAST_CHAIN_ROTATOR;
+    	stage.fir = NULL;
+    	stage.decimation = 1;
+    	stage.phaseIncrement = phaseIncrement;
+    	stage.phase = 0.0;
+
+    	stages.push_back(stage);
+    	numTileStages++;
+
+    	updateGeometry();
     }
 
-    void FIRFilterCCC_MT::runThread16(long startIndex,long numSamples) {
-    	if (decimating()) {
-    		long decIndex = calcDecimationIndex(startIndex);
+    void FilterChainCCF::addAGC(float rate, float reference, float gain, float maxGain) {
+    	ChainStage stage = ChainStage();
+    	stage.type = LFAST_CHAIN_AGC;
+    	stage.fir = NULL;
+    	stage.decimation = 1;
+    	stage.agcRate = rate;
+    	stage.reference = reference;
+    	stage.initialGain = gain;
+    	stage.gain = gain;
+    	stage.maxGain = maxGain;
 
-    		FIRFilterCCC::filterNdec(&pOutputBuffer[decIndex],&pInputBuffer[startIndex],numSamples,decimation);
-    	}
-    	else {
-    		FIRFilterCCC::filterN(&pOutputBuffer[startIndex],&pInputBuffer[startIndex],numSamples);
-    	}
-    	threadRunning[15] = false;
+    	stages.push_back(stage);
+
+    	updateGeometry();
     }
 
-	// NOTE: This routine is expecting numSamples to be an integer multiple of the number of taps
-	long FIRFilterCCC_MT::filterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples) {
-		while (anyThreadRunning() || (threadReady == false))
-			usleep(10);
+    void FilterChainCCF::updateGeometry() {
+    	// Walk back from the output: each FIR stage multiplies the rate by its decimation and
+    	// needs ntaps-1 samples in front of its first output's window.
+    	long rate = 1;
+    	long start = 0;
 
-		pInputBuffer = inputBuffer;
-		pOutputBuffer = outputBuffer;
+    	for (int i=numTileStages-1;i>=0;i--) {
+    		if (stages[i].type == LFAST_CHAIN_FIR) {
+    			rate *= stages[i].decimation;
+    			start = start*stages[i].decimation - (stages[i].fir->ntaps() - 1);
+    		}
 
-		long blockSize = numSamples / d_nthreads;
-		long lastBlock = numSamples - (d_nthreads-1)*blockSize;
-		threadReady = false;
+    		stages[i].rate = rate;
+    	}
 
-		int curBlock;
+    	for (size_t i=numTileStages;i<stages.size();i++)
+    		stages[i].rate = 1;
 
-		// std::cout << "Starting threads.  numSamples = " << numSamples << " Block size =" << blockSize << " last block=" << lastBlock << std::endl;
+    	totalDecimation = rate;
+    	history = -start;
+    }
 
-		for (int i=0;i<d_nthreads;i++) {
-			threadRunning[i] = true;
+    void FilterChainCCF::reset() {
+    	for (size_t i=0;i<stages.size();i++) {
+    		stages[i].phase = 0.0;
+    		stages[i].gain = stages[i].initialGain;
+    	}
+    }
 
-			if (i<(d_nthreads-1))
-				curBlock = blockSize;
-			else
-				curBlock = lastBlock;
+    void FilterChainCCF::filterTile(gr_complex *outputBuffer, const gr_complex *inputBuffer, long firstOutput, long numOutputs, int threadIndex) {
+    	if (numTileStages == 0) {
+    		memcpy(&outputBuffer[firstOutput],inputBuffer,numOutputs*sizeof(gr_complex));
+    		return;
+    	}
 
-			switch(i) {
-			case 0:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread1, this,i*blockSize,curBlock));
-				break;
-			case 1:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread2, this,i*blockSize,curBlock));
-				break;
-			case 2:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread3, this,i*blockSize,curBlock));
-				break;
-			case 3:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread4, this,i*blockSize,curBlock));
-				break;
-			case 4:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread5, this,i*blockSize,curBlock));
-				break;
-			case 5:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread6, this,i*blockSize,curBlock));
-				break;
-			case 6:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread7, this,i*blockSize,curBlock));
-				break;
-			case 7:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread8, this,i*blockSize,curBlock));
-				break;
-			case 8:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread9, this,i*blockSize,curBlock));
-				break;
-			case 9:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread10, this,i*blockSize,curBlock));
-				break;
-			case 10:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread11, this,i*blockSize,curBlock));
-				break;
-			case 11:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread12, this,i*blockSize,curBlock));
-				break;
-			case 12:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread13, this,i*blockSize,curBlock));
-				break;
-			case 13:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread14, this,i*blockSize,curBlock));
-				break;
-			case 14:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread15, this,i*blockSize,curBlock));
-				break;
-			case 15:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread16, this,i*blockSize,curBlock));
-				break;
-			}
-		}
+    	// Per stage input: length, and first sample relative to the call's first new sample at that rate
+    	long *lengths = tileGeometry.get(threadIndex,2*(numTileStages+1));
+    	long *starts = &lengths[numTileStages+1];
 
-		// std::cout << "Waiting for threads to finish." << std::endl;
-		while (anyThreadRunning())
-			usleep(10);
+    	lengths[numTileStages] = numOutputs;
+    	starts[numTileStages] = firstOutput;
 
-		//std::cout << "Threads finished." << std::endl;
-		for (int i=0;i<d_nthreads;i++) {
-			delete threads[i];
-			threads[i] = NULL;
-		}
+    	for (int i=numTileStages-1;i>=0;i--) {
+    		if (stages[i].type == LFAST_CHAIN_FIR) {
+    			long nextLength = lengths[i+1];
+    			lengths[i] = (nextLength - 1)*stages[i].decimation + stages[i].fir->ntaps();
+    			starts[i] = starts[i+1]*stages[i].decimation - (stages[i].fir->ntaps() - 1);
+    		}
+    		else {
+    			lengths[i] = lengths[i+1];
+    			starts[i] = starts[i+1];
+    		}
+    	}
 
-		threadReady = true;
+    	const gr_complex *in = &inputBuffer[history + starts[0]];
 
-		return numSamples;
-	}
+    	for (int i=0;i<numTileStages;i++) {
+    		gr_complex *out;
 
-	// OutputBuffer here should be at least numSamples/decimation in length
-	long FIRFilterCCC_MT::filterNdec(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation) {
-		while (anyThreadRunning() || (threadReady == false))
-			usleep(10);
+    		if (i == numTileStages - 1)
+    			out = &outputBuffer[firstOutput];
+    		else
+    			out = tileBuffers[i & 1].get(threadIndex,lengths[i+1]);
 
-		pInputBuffer = inputBuffer;
-		pOutputBuffer = outputBuffer;
+    		if (stages[i].type == LFAST_CHAIN_FIR) {
+    			if (stages[i].decimation == 1)
+    				stages[i].fir->filterN(out,in,lengths[i+1]);
+    			else
+    				stages[i].fir->filterNdec(out,in,lengths[i+1]*stages[i].decimation,stages[i].decimation);
+    		}
+    		else {
+    			// Phase is a function of the sample's position, so any tile can start anywhere
+    			double startPhase = fmod(stages[i].phase + (double)starts[i] * stages[i].phaseIncrement,2.0*M_PI);
+    			lv_32fc_t phase = std::polar(1.0f,(float)startPhase);
+    			lv_32fc_t phaseIncrement = std::polar(1.0f,(float)stages[i].phaseIncrement);
 
-		numSamples = numSamples * decimation;
-		long blockSize = calcDecimationBlockSize(numSamples);
+    			volk_32fc_s32fc_x2_rotator_32fc(out,in,phaseIncrement,&phase,lengths[i]);
+    		}
 
-		long lastBlock = numSamples - (d_nthreads-1)*blockSize;
-		threadReady = false;
+    		in = out;
+    	}
+    }
 
-		int curBlock;
+    long FilterChainCCF::filterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numOutputs) {
+    	if (numOutputs <= 0)
+    		return 0;
 
-		// std::cout << "Starting threads.  numSamples = " << numSamples << " Block size =" << blockSize << " last block=" << lastBlock << std::endl;
+    	long outputsPerTile = tileSize;
 
-		for (int i=0;i<d_nthreads;i++) {
-			threadRunning[i] = true;
+    	if (outputsPerTile <= 0) {
+    		outputsPerTile = std::max(1L,LFAST_CHAIN_TILE_SAMPLES / totalDecimation);
+    		// Enough tiles to go around
+    		outputsPerTile = std::min(outputsPerTile,(numOutputs + d_nthreads - 1) / d_nthreads);
+    	}
 
-			if (i<(d_nthreads-1))
-				curBlock = blockSize;
-			else
-				curBlock = lastBlock;
+    	long numTiles = (numOutputs + outputsPerTile - 1) / outputsPerTile;
 
-			switch(i) {
-			case 0:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread1, this,i*blockSize,curBlock));
-				break;
-			case 1:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread2, this,i*blockSize,curBlock));
-				break;
-			case 2:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread3, this,i*blockSize,curBlock));
-				break;
-			case 3:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread4, this,i*blockSize,curBlock));
-				break;
-			case 4:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread5, this,i*blockSize,curBlock));
-				break;
-			case 5:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread6, this,i*blockSize,curBlock));
-				break;
-			case 6:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread7, this,i*blockSize,curBlock));
-				break;
-			case 7:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread8, this,i*blockSize,curBlock));
-				break;
-			case 8:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread9, this,i*blockSize,curBlock));
-				break;
-			case 9:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread10, this,i*blockSize,curBlock));
-				break;
-			case 10:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread11, this,i*blockSize,curBlock));
-				break;
-			case 11:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread12, this,i*blockSize,curBlock));
-				break;
-			case 12:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread13, this,i*blockSize,curBlock));
-				break;
-			case 13:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread14, this,i*blockSize,curBlock));
-				break;
-			case 14:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread15, this,i*blockSize,curBlock));
-				break;
-			case 15:
-	    		threads[i] = new boost::thread(boost::bind(&FIRFilterCCC_MT::runThread16, this,i*blockSize,curBlock));
-				break;
-			}
-		}
+    	tileBuffers[0].reserve(d_nthreads);
+    	tileBuffers[1].reserve(d_nthreads);
+    	tileGeometry.reserve(d_nthreads);
 
-		// std::cout << "Waiting for threads to finish." << std::endl;
-		while (anyThreadRunning())
-			usleep(10);
+    	parallelFor(numTiles,[=](long startIndex, long numItems, int threadIndex) {
+    		for (long tile=startIndex;tile<startIndex+numItems;tile++) {
+    			long firstOutput = tile*outputsPerTile;
 
-		// std::cout << "Threads finished." << std::endl;
-		for (int i=0;i<d_nthreads;i++) {
-			delete threads[i];
-			threads[i] = NULL;
-		}
+    			filterTile(outputBuffer,inputBuffer,firstOutput,std::min(outputsPerTile,numOutputs - firstOutput),threadIndex);
+    		}
+    	});
 
-		threadReady = true;
+    	// Next call's first new sample follows this call's last
+    	for (int i=0;i<numTileStages;i++) {
+    		if (stages[i].type == LFAST_CHAIN_ROTATOR)
+    			stages[i].phase = fmod(stages[i].phase + (double)(numOutputs*stages[i].rate) * stages[i].phaseIncrement,2.0*M_PI);
+    	}
 
-		return numSamples;
-	}
+    	// Gain feedback makes AGC sequential
+    	for (size_t i=numTileStages;i<stages.size();i++) {
+    		ChainStage &agc = stages[i];
 
-  } // end lfast
-} // end gr
+    		for (long n=0;n<numOutputs;n++) {
+    			gr_complex output = outputBuffer[n] * agc.gain;
+    			outputBuffer[n] = output;
 
+    			agc.gain += agc.agcRate * (agc.reference - sqrt(output.real()*output.real() + output.imag()*output.imag()));
 
+    			if ((agc.maxGain > 0.0) && (agc.gain > agc.maxGain))
+    				agc.gain = agc.maxGain;
+    		}
+    	}
 
+    	return numOutputs;
+    }
+
+  } // end lfast
+} // end gr
@@ -21,13 +21,52 @@
 #define INCLUDE_LFAST_FIR_FILTER_LFAST_H_
 
 #include <gnuradio/gr_complex.h>
+#include <gnuradio/fft/fft.h>
 
 #include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <volk/volk.h>
+#include "fir_blocked_lfast.h"
+#include "mirrored_buffer_lfast.h"
+#include "affinity_lfast.h"
+#include <string>
+#include <algorithm>
+#include <atomic>
 using namespace std;
 
 namespace gr {
   namespace lfast {
+	/*
+	 * Aligned VOLK dot products selected by type so templated kernels can share one implementation.
+	 * input and taps must both be on a volk_get_alignment() boundary.
+	 */
+	inline void dotProdAligned(gr_complex *result, const gr_complex *input, const float *taps, long numTaps) {
+		volk_32fc_32f_dot_prod_32fc_a(result,input,taps,numTaps);
+	}
+
+	inline void dotProdAligned(float *result, const float *input, const float *taps, long numTaps) {
+		volk_32f_x2_dot_prod_32f_a(result,input,taps,numTaps);
+	}
+
+	inline void dotProdAligned(gr_complex *result, const gr_complex *input, const gr_complex *taps, long numTaps) {
+		volk_32fc_x2_dot_prod_32fc_a(result,input,taps,numTaps);
+	}
+
+	inline const char *dotProdAlignedName(const gr_complex *input, const float *taps) { return "volk_32fc_32f_dot_prod_32fc_a"; }
+	inline const char *dotProdAlignedName(const float *input, const float *taps) { return "volk_32f_x2_dot_prod_32f_a"; }
+	inline const char *dotProdAlignedName(const gr_complex *input, const gr_complex *taps) { return "volk_32fc_x2_dot_prod_32fc_a"; }
+
+	// Tap symmetry found by setTaps
+#define LFAST_TAPS_ASYMMETRIC 0
+#define LFAST_TAPS_SYMMETRIC 1
+#define LFAST_TAPS_ANTISYMMETRIC 2
+
+	// Symmetric (folded) fast path modes
+#define LFAST_SYMMETRY_AUTO 0
+#define LFAST_SYMMETRY_OFF 1
+#define LFAST_SYMMETRY_FORCE 2
+
 	/*
 	 * Base Filter
 	 */
@@ -36,9 +75,51 @@ namespace gr {
 	protected:
 		tap_type *alignedTaps;
 		io_type *singlePointBuffer;
+		// Reversed taps as applied.  userTaps keeps them as passed to setTaps, since
+		// LFAST_SYMMETRY_FORCE may fold d_taps, so getTaps() and mode changes are lossless.
 		std::vector<tap_type> d_taps;
+		std::vector<tap_type> userTaps;
 		long numTaps;
 
+		// One copy of the reversed taps per input alignment offset (as the stock fir_filter does).
+		// Copy k is shifted right by k samples and zero-padded, so a dot product for an input k samples
+		// past an aligned address can start at that aligned address with the aligned volk kernel.
+		// alignedTaps points at copy 0.
+		std::vector<tap_type *> alignedTapSets;
+		int alignmentSamples;
+		size_t alignmentMask;
+
+		void buildAlignedTapSets();
+		void freeAlignedTapSets();
+
+		// Polyphase decimator sub-filters.  Sub-filter p holds reversed taps p, p+D, p+2D, ...
+		// so it lines up with input phase lane p (samples p, p+D, p+2D, ...).
+		int polyphaseDecimation;
+		std::vector<tap_type *> polyphaseTaps;
+		std::vector<long> polyphaseLength;
+		long maxPolyphaseLength;
+
+		void buildPolyphaseTaps();
+		void freePolyphaseTaps();
+
+		// Use the register-blocked kernels (fir_blocked_lfast.h) for filterN when the CPU has them
+		bool blockedKernel;
+
+		// push() state: the last ntaps()-1 input samples, and an aligned buffer to join them to the next call's input
+		std::vector<io_type> streamHistory;
+		io_type *stitchBuffer;
+		long stitchBufferSize;
+
+		// getWriteBuffer()/pushWritten() state: samples live in a mirrored ring so every window is contiguous
+		MirroredBuffer<io_type> *streamRing;
+		size_t ringHead;
+
+		// Linear-phase taps can use the folded kernels.  tapSymmetry is recomputed on every setTaps.
+		int symmetryMode;
+		int tapSymmetry;
+
+		void checkSymmetry();
+
 	public:
 		Filter();
 		Filter(const std::vector<tap_type>& newTaps);
@@ -48,11 +129,80 @@ namespace gr {
 		// For compatibility
 		inline virtual void set_taps(const std::vector<tap_type>& newTaps) { setTaps(newTaps); };
 		virtual std::vector<tap_type> getTaps() const;
+		// The taps actually filtered with (differs from getTaps() only after LFAST_SYMMETRY_FORCE folded them)
+		std::vector<tap_type> getAppliedTaps() const;
+
+		// Exchanges all tap state (taps, aligned copies, polyphase sub-filters) with other.
+		// Only pointers are exchanged, so a tap set can be built in a standby filter off the
+		// streaming thread and swapped in between calls.
+		void swapTaps(Filter<io_type,tap_type> &other);
 		inline virtual std::vector<tap_type> taps() const { return getTaps();};
 		inline virtual long ntaps() { return numTaps;};
+		// Reversed, aligned taps as applied by the dot products
+		inline const tap_type *getAlignedTaps() const { return alignedTaps; };
+
+		// output = dot(input[0..ntaps-1], reversed taps) using the aligned kernel and the tap copy matching
+		// input's alignment.  Reads back to the previous aligned address, so input must not be within
+		// volk_get_alignment() bytes after the start of an unaligned allocation (GR and volk buffers are aligned).
+		inline void alignedDotProd(io_type *result, const io_type *input) const {
+			size_t offset = ((size_t)input & alignmentMask) / sizeof(io_type);
+			dotProdAligned(result,input - offset,alignedTapSets[offset],numTaps + offset);
+		};
+
+		// Alignment in bytes the aligned kernels are run at, and the number of shifted tap copies kept for it
+		inline int getAlignment() const { return (int)(alignmentMask + 1); };
+		inline int getNumAlignedTapSets() const { return alignmentSamples; };
+
+		// Human-readable description of the dot product kernel, volk machine, and alignment in use
+		std::string getKernelInfo() const;
+
+		// Enables/disables the register-blocked filterN kernels (on by default)
+		inline void setBlockedKernel(bool enable) { blockedKernel = enable; };
+		inline bool getBlockedKernel() const { return blockedKernel; };
+
+		// LFAST_SYMMETRY_AUTO folds the taps when setTaps finds them symmetric or antisymmetric,
+		// LFAST_SYMMETRY_OFF never folds.  LFAST_SYMMETRY_FORCE always folds: the applied taps are replaced with
+		// their symmetric (or antisymmetric, whichever dominates) part, for linear-phase taps that lost exact
+		// symmetry to rounding (e.g. loaded from a file).  getTaps() still returns the taps as set, and
+		// changing the mode reapplies them.
+		virtual void setSymmetryMode(int mode);
+		inline int getSymmetryMode() const { return symmetryMode; };
+		// One of LFAST_TAPS_ASYMMETRIC, LFAST_TAPS_SYMMETRIC, LFAST_TAPS_ANTISYMMETRIC
+		inline int getTapSymmetry() const { return tapSymmetry; };
+		inline bool useFolded() const { return blockedKernel && symmetryMode != LFAST_SYMMETRY_OFF && tapSymmetry != LFAST_TAPS_ASYMMETRIC; };
+
+		// Splits the taps into decimation sub-filters for filterNdecPolyphase.  1 disables it.
+		// Sub-filters are rebuilt automatically on setTaps.
+		virtual void setPolyphaseDecimation(int decimation);
+		inline virtual int getPolyphaseDecimation() { return polyphaseDecimation; };
+
+		// Minimum laneBuffer length (in samples) filterNdecPolyphase needs for numSamples input samples
+		inline long polyphaseLaneSize(long numSamples) { return numSamples / polyphaseDecimation + maxPolyphaseLength; };
 
 		// Returns number of samples consumed / produced
 		virtual long filter(io_type *outputBuffer, const io_type *inputBuffer, long numSamples) {return 0;};
+
+		// numSamples outputs from numSamples + ntaps() - 1 inputs (ntaps()-1 samples of history first).
+		// The data-type filters override this with their own kernels.
+		virtual long filterN(io_type *outputBuffer, const io_type *inputBuffer, long numSamples);
+
+		// Stateful streaming for callers outside the GNU Radio scheduler: filters numSamples new samples
+		// into numSamples outputs, carrying the history between calls, so any chunk size can be fed in
+		// without the caller keeping history in front of its buffer.  Only the first ntaps()-1 (plus
+		// alignment) outputs of each call are computed from an internal copy joining the history to the
+		// new input; the rest run directly on inputBuffer.  History starts zeroed, is kept across setTaps
+		// (padded or trimmed to the new length), and is cleared with resetHistory().
+		long push(const io_type *inputBuffer, long numSamples, io_type *outputBuffer);
+		void resetHistory();
+
+		// Zero-copy streaming: the caller writes (or receives) numSamples new samples straight into the
+		// pointer from getWriteBuffer(numSamples), then pushWritten(numSamples, out) filters them.  The samples
+		// are kept in a double-mapped ring (mirrored_buffer_lfast.h) right after their history, so nothing is
+		// copied and the window never has to be stitched across the wrap.  The ring is only reallocated when
+		// numSamples + ntaps() - 1 outgrows it, keeping the last ntaps()-1 samples.  Shares resetHistory()
+		// with push(), but the two keep separate history so don't mix them on one stream.
+		io_type *getWriteBuffer(long numSamples);
+		long pushWritten(long numSamples, io_type *outputBuffer);
 	}; // end base filter template
 
 	/*
@@ -70,6 +220,11 @@ namespace gr {
 		// OutputBuffer here should be at least numSamples/decimation in length
 		virtual long filterNdec(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation);
 
+		// Polyphase version of filterNdec.  Each phase of the input is de-interleaved into laneBuffer
+		// (at least polyphaseLaneSize(numSamples) long) and run against its contiguous sub-filter.
+		// Falls back to filterNdec for decimation 1 or if setPolyphaseDecimation(decimation) hasn't been called.
+		virtual long filterNdecPolyphase(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation, gr_complex *laneBuffer);
+
 		virtual gr_complex filter(const gr_complex *inputBuffer);
 
 		// This is for testing comparison.  This function does all calculations in 1 CPU-based thread.
@@ -91,6 +246,11 @@ namespace gr {
 		// OutputBuffer here should be at least numSamples/decimation in length
 		virtual long filterNdec(float *outputBuffer, const float *inputBuffer, long numSamples, int decimation);
 
+		// Polyphase version of filterNdec.  Each phase of the input is de-interleaved into laneBuffer
+		// (at least polyphaseLaneSize(numSamples) long) and run against its contiguous sub-filter.
+		// Falls back to filterNdec for decimation 1 or if setPolyphaseDecimation(decimation) hasn't been called.
+		virtual long filterNdecPolyphase(float *outputBuffer, const float *inputBuffer, long numSamples, int decimation, float *laneBuffer);
+
 		virtual gr_complex filter(const float *inputBuffer);
 
 		// This is for testing comparison.  This function does all calculations in 1 CPU-based thread.
@@ -112,35 +272,160 @@ namespace gr {
 		// OutputBuffer here should be at least numSamples/decimation in length
 		virtual long filterNdec(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation);
 
+		// Polyphase version of filterNdec.  Each phase of the input is de-interleaved into laneBuffer
+		// (at least polyphaseLaneSize(numSamples) long) and run against its contiguous sub-filter.
+		// Falls back to filterNdec for decimation 1 or if setPolyphaseDecimation(decimation) hasn't been called.
+		virtual long filterNdecPolyphase(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation, gr_complex *laneBuffer);
+
 		virtual gr_complex filter(const gr_complex *inputBuffer);
 
 		// This is for testing comparison.  This function does all calculations in 1 CPU-based thread.
 		virtual long filterCPU(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples);
     };
 
+	/*
+	 * Overlap-save FFT convolution.
+	 * Produces the same outputs as the direct-form filters (input includes ntaps-1 history samples)
+	 * but costs O(log fftSize) per output instead of O(ntaps), so it wins for long filters.
+	 * Each FFT block is independent, so the multi-threaded filters hand out whole blocks
+	 * to their threads with filterBlocks().  Complex FFTs are used for all data types.
+	 */
+    template<class io_type, class tap_type>
+	class FFTFilter:public Filter<io_type,tap_type> {
+	protected:
+		int fftSize;
+		// Outputs (at the input rate) produced per FFT block: fftSize - ntaps + 1
+		long blockLength;
+		// Transformed taps, with the 1/fftSize inverse FFT scaling folded in
+		gr_complex *tapsFFT;
+		bool tapsFFTValid;
+		// FFT size the plans below were created for
+		int planSize;
+
+		// One forward/reverse pair per thread.  Slot i is only used by thread i.
+		std::vector<gr::fft::fft_complex_fwd *> fwdFFTs;
+		std::vector<gr::fft::fft_complex_rev *> revFFTs;
+
+		void buildTapsFFT();
+		void clearFFTs();
+
+	public:
+		FFTFilter();
+		FFTFilter(const std::vector<tap_type>& newTaps);
+		virtual ~FFTFilter();
+
+		virtual void setTaps(const std::vector<tap_type>& newTaps);
+
+		// Exchanges tap state including the tap transform.  Each filter keeps its own FFT plans.
+		void swapTaps(FFTFilter<io_type,tap_type> &other);
+
+		// Power of 2 at least 4x the taps so most of each block is usable output
+		static int fftSizeForTaps(long ntaps);
+
+		// Rough op-count model: true when numOutputs (decimated) outputs are cheaper with FFT blocks
+		// than with ntaps-long dot products.
+		static bool fasterThanDirect(long ntaps, long numOutputs, int decimation=1);
+
+		inline int getFFTSize() { return fftSize; };
+
+		// Number of FFT blocks needed for numOutputs outputs at the given decimation
+		long numBlocks(long numOutputs, int decimation=1);
+
+		// Builds the tap transform and per-thread FFT plans.  Call from the calling thread before filterBlocks.
+		// prepare(0) just builds the tap transform.
+		void prepare(int nthreads);
+
+		// Computes blocks [firstBlock, firstBlock+blockCount) of a numOutputs-long (decimated) output
+		// using FFT workspace "workspace".  Output n is taken at input position n*decimation.
+		void filterBlocks(io_type *outputBuffer, const io_type *inputBuffer, long numOutputs, int decimation,
+				long firstBlock, long blockCount, int workspace);
+
+		// Single-threaded versions matching the FIRFilter calls
+		virtual long filterN(io_type *outputBuffer, const io_type *inputBuffer, long numSamples);
+		// numSamples is the input count; produces numSamples/decimation outputs
+		virtual long filterNdec(io_type *outputBuffer, const io_type *inputBuffer, long numSamples, int decimation);
+	};
+
+    typedef FFTFilter<gr_complex,float> FFTFilterCCF;
+    typedef FFTFilter<float,float> FFTFilterFFF;
+    typedef FFTFilter<gr_complex,gr_complex> FFTFilterCCC;
 
     // -----------------------------------------------------------------
     // ------  Multi-threaded filters ----------------------------------
     // -----------------------------------------------------------------
 
+    // Engine choices for the multi-threaded FIR filters
+#define LFAST_FILTER_ENGINE_AUTO 0
+#define LFAST_FILTER_ENGINE_DIRECT 1
+#define LFAST_FILTER_ENGINE_FFT 2
+
+    // MTBase chunk sizes: automatic (about LFAST_CHUNKS_PER_THREAD chunks per thread), or one equal block per thread
+#define LFAST_CHUNK_AUTO 0
+#define LFAST_CHUNK_STATIC -1
+#define LFAST_CHUNKS_PER_THREAD 8
+
 	/*
-	 * Multi-threaded base template.
-	 * Provides threading and buffers
+	 * Multi-threaded base.
+	 * Owns a persistent pool of worker threads and splits an index range across them.
+	 * New multi-threaded kernels just call parallelFor() with a functor taking
+	 * (startIndex, numItems, threadIndex) for their chunk.
+	 *
+	 * The range is cut into small chunks that the threads (calling thread included) pull from a
+	 * shared atomic counter until none are left, so a preempted or slower core just ends up running
+	 * fewer chunks instead of holding up the whole call.
 	 *
 	 */
-    template<class io_type>
-	class MTBase {
+    class MTBase {
 	protected:
-		const io_type *pInputBuffer;
-		io_type *pOutputBuffer;
+        struct MTWorker {
+        	boost::thread *thread;
+        	bool running;
+        	bool exit;
+        	// Only written by the thread itself, read once the call completes
+        	long chunksRun;
+        };
+
+        // Worker threads are created once and parked on a condition variable between calls
+        // so each filter call costs a wakeup rather than a thread create/destroy.
+        // Thread 0 is the calling thread, so workers[0].thread is never used.
+        std::vector<MTWorker> workers;
+        int threadsPending;
+
+        boost::mutex poolMutex;
+        boost::condition_variable workReady;
+        boost::condition_variable workDone;
 
-        // Supports up to 16 threads
-        boost::thread *threads[16];
-        bool threadRunning[16];
-		bool threadReady;
         int d_nthreads;
-		int decimation;
 
+        // Type-erased pointer to the functor passed to parallelFor (avoids a std::function allocation per call)
+        void (*chunkFunction)(const void *context, long startIndex, long numItems, int threadIndex);
+        const void *chunkContext;
+
+        // Current call: items and chunk size, and the next unclaimed index
+        long runItems;
+        long runChunkSize;
+        std::atomic<long> nextIndex;
+        long chunkSize;
+
+        // Worker placement (affinity_lfast.h).  Resolved on the next call, from the calling thread's CPU.
+        int affinityPolicy;
+        std::vector<int> affinityCores;
+        bool affinityPending;
+
+        void applyAffinity();
+
+		template<class Func> static void callChunk(const void *context, long startIndex, long numItems, int threadIndex) {
+			(*(const Func *)context)(startIndex,numItems,threadIndex);
+		}
+
+		void threadLoop(int threadIndex);
+		void stopThread(int threadIndex);
+
+		// Claims and runs chunks of the current call until none are left
+		void runChunks(int threadIndex);
+
+		// Splits [0, numItems) into chunks across the threads and returns once all are complete.
+		void runThreads(long numItems);
 
 	public:
 		MTBase(int nthreads=4);
@@ -148,45 +433,90 @@ namespace gr {
 
 		int numThreads() { return d_nthreads; };
 
-		inline virtual void setDecimation(int newDecimation) { decimation = newDecimation; };
-		inline virtual int getDecimation() { return decimation; };
-		inline virtual bool decimating() { if (decimation > 1) return true; else return false; };
+		// Upper limit on setThreads() (the number of hardware threads on this machine)
+		static int maxThreads();
 
-		virtual long calcDecimationBlockSize(long numSamples);
+		// Calls fn(startIndex, numItems, threadIndex) for each chunk of [0, numItems), possibly several times
+		// per thread, so fn must handle any sub-range.  threadIndex 0 is the calling thread.
+		// Only one parallelFor may be in progress at a time.
+		template<class Func> void parallelFor(long numItems, const Func &fn) {
+			chunkContext = (const void *)&fn;
+			chunkFunction = &MTBase::callChunk<Func>;
 
-		// NOTE: calcDecimationIndex assumes the index is an even multiple of a decimation block size
-		// In other words, calcDecimationBlockSize was called to get an appropriate block size,
-		// then blockStartIndex is an integer multiple of that result.
-		virtual long calcDecimationIndex(long blockStartIndex);
+			runThreads(numItems);
+		}
 
-		// NOTE: This method IS NOT thread-safe.  Make sure to use a scoped_lock or be sure no threads are running
+		// NOTE: This method IS NOT thread-safe.  Make sure to use a scoped_lock or be sure no filter call is in progress
 		// before changing the number of threads.
 		virtual void setThreads(int nthreads);
 
 		virtual bool anyThreadRunning();
+
+		// Chunk size in parallelFor items (output samples for the direct filters, FFT blocks for the
+		// FFT engine), or LFAST_CHUNK_AUTO / LFAST_CHUNK_STATIC.  Same threading caveat as setThreads().
+		void setChunkSize(long items) { chunkSize = items; };
+		long getChunkSize() const { return chunkSize; };
+
+		// Chunks each thread has run since the last resetChunkCounts() (index 0 is the calling thread),
+		// to check the balance under load.  Call between filter calls.
+		std::vector<long> getChunkCounts();
+		void resetChunkCounts();
+
+		// LFAST_AFFINITY_* policy for the worker threads (the calling thread is left alone).
+		// cores is only used with LFAST_AFFINITY_CORES.  Takes effect on the next call, since the
+		// socket / NUMA policies are relative to the thread calling the filter.  Same threading caveat as setThreads().
+		void setAffinity(int policy, const std::vector<int> &cores=std::vector<int>());
+		int getAffinity() const { return affinityPolicy; };
     };
 
+	/*
+	 * Per-thread scratch buffers for multi-threaded kernels.
+	 * reserve() must be called from the calling thread before parallelFor,
+	 * then thread i only ever touches slot i.
+	 */
+    template<class T>
+	class ThreadBuffers {
+	protected:
+		std::vector<T *> buffers;
+		std::vector<long> sizes;
+
+	public:
+		ThreadBuffers() {};
+		virtual ~ThreadBuffers() {
+			for (size_t i=0;i<buffers.size();i++) {
+				if (buffers[i])
+					volk_free(buffers[i]);
+			}
+		};
+
+		void reserve(int nthreads) {
+			if (nthreads > (int)buffers.size()) {
+				buffers.resize(nthreads,NULL);
+				sizes.resize(nthreads,0);
+			}
+		};
+
+		T *get(int threadIndex, long minSize) {
+			if (sizes[threadIndex] < minSize) {
+				if (buffers[threadIndex])
+					volk_free(buffers[threadIndex]);
+
+				buffers[threadIndex] = (T *)volk_malloc(minSize*sizeof(T),volk_get_alignment());
+				sizes[threadIndex] = minSize;
+			}
+
+			return buffers[threadIndex];
+		};
+	};
+
     // --------------------------------------------------
     // Multi-threaded filter, complex data, float taps
     // --------------------------------------------------
-    class FIRFilterCCF_MT:public MTBase<gr_complex>, public FIRFilterCCF {
+    class FIRFilterCCF_MT:public MTBase, public FIRFilterCCF {
     protected:
-		virtual void runThread1(long startIndex,long numSamples);
-		virtual void runThread2(long startIndex,long numSamples);
-		virtual void runThread3(long startIndex,long numSamples);
-		virtual void runThread4(long startIndex,long numSamples);
-		virtual void runThread5(long startIndex,long numSamples);
-		virtual void runThread6(long startIndex,long numSamples);
-		virtual void runThread7(long startIndex,long numSamples);
-		virtual void runThread8(long startIndex,long numSamples);
-		virtual void runThread9(long startIndex,long numSamples);
-		virtual void runThread10(long startIndex,long numSamples);
-		virtual void runThread11(long startIndex,long numSamples);
-		virtual void runThread12(long startIndex,long numSamples);
-		virtual void runThread13(long startIndex,long numSamples);
-		virtual void runThread14(long startIndex,long numSamples);
-		virtual void runThread15(long startIndex,long numSamples);
-		virtual void runThread16(long startIndex,long numSamples);
+		ThreadBuffers<gr_complex> laneBuffers;
+		FFTFilterCCF fftFilter;
+		int engine;
 
     public:
     	FIRFilterCCF_MT(int nthreads);
@@ -199,29 +529,38 @@ namespace gr {
 		// OutputBuffer here should be at least numSamples/decimation in length
 		virtual long filterNdec(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation);
 
+		// Multi-threaded polyphase decimator.  numSamples is the decimated count, as with filterNdec.
+		virtual long filterNdecPolyphase(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation);
+
+		virtual void setTaps(const std::vector<float>& newTaps);
+
+		// Swaps tap state with a standby filter (see Filter::swapTaps)
+		void swapTaps(FIRFilterCCF_MT &other);
+
+		// Builds anything the taps need ahead of the first call (the FFT tap transform).
+		// Used on standby filters so the swap itself is cheap.
+		void prepareTaps();
+
+		// Engine selection for useFFT()
+		inline void setEngine(int newEngine) { engine = newEngine; };
+		inline int getEngine() { return engine; };
+
+		// True if the overlap-save engine should be used for a numSamples (decimated) call
+		bool useFFT(long numSamples, int decimation=1);
+
+		// Multi-threaded overlap-save filter.  numSamples is the decimated count, as with filterNdec.
+		virtual long filterNFFT(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation=1);
+
     };
 
     // --------------------------------------------------
-    // Multi-threaded filter, complex data, float taps
+    // Multi-threaded filter, float data, float taps
     // --------------------------------------------------
-    class FIRFilterFFF_MT:public MTBase<float>, public FIRFilterFFF {
+    class FIRFilterFFF_MT:public MTBase, public FIRFilterFFF {
     protected:
-		virtual void runThread1(long startIndex,long numSamples);
-		virtual void runThread2(long startIndex,long numSamples);
-		virtual void runThread3(long startIndex,long numSamples);
-		virtual void runThread4(long startIndex,long numSamples);
-		virtual void runThread5(long startIndex,long numSamples);
-		virtual void runThread6(long startIndex,long numSamples);
-		virtual void runThread7(long startIndex,long numSamples);
-		virtual void runThread8(long startIndex,long numSamples);
-		virtual void runThread9(long startIndex,long numSamples);
-		virtual void runThread10(long startIndex,long numSamples);
-		virtual void runThread11(long startIndex,long numSamples);
-		virtual void runThread12(long startIndex,long numSamples);
-		virtual void runThread13(long startIndex,long numSamples);
-		virtual void runThread14(long startIndex,long numSamples);
-		virtual void runThread15(long startIndex,long numSamples);
-		virtual void runThread16(long startIndex,long numSamples);
+		ThreadBuffers<float> laneBuffers;
+		FFTFilterFFF fftFilter;
+		int engine;
 
     public:
     	FIRFilterFFF_MT(int nthreads);
@@ -233,29 +572,38 @@ namespace gr {
 
 		// OutputBuffer here should be at least numSamples/decimation in length
 		virtual long filterNdec(float *outputBuffer, const float *inputBuffer, long numSamples, int decimation);
+
+		// Multi-threaded polyphase decimator.  numSamples is the decimated count, as with filterNdec.
+		virtual long filterNdecPolyphase(float *outputBuffer, const float *inputBuffer, long numSamples, int decimation);
+
+		virtual void setTaps(const std::vector<float>& newTaps);
+
+		// Swaps tap state with a standby filter (see Filter::swapTaps)
+		void swapTaps(FIRFilterFFF_MT &other);
+
+		// Builds anything the taps need ahead of the first call (the FFT tap transform).
+		// Used on standby filters so the swap itself is cheap.
+		void prepareTaps();
+
+		// Engine selection for useFFT()
+		inline void setEngine(int newEngine) { engine = newEngine; };
+		inline int getEngine() { return engine; };
+
+		// True if the overlap-save engine should be used for a numSamples (decimated) call
+		bool useFFT(long numSamples, int decimation=1);
+
+		// Multi-threaded overlap-save filter.  numSamples is the decimated count, as with filterNdec.
+		virtual long filterNFFT(float *outputBuffer, const float *inputBuffer, long numSamples, int decimation=1);
     };
 
     // --------------------------------------------------
     // Multi-threaded filter, complex data, complex taps
     // --------------------------------------------------
-    class FIRFilterCCC_MT:public MTBase<gr_complex>, public FIRFilterCCC {
+    class FIRFilterCCC_MT:public MTBase, public FIRFilterCCC {
     protected:
-		virtual void runThread1(long startIndex,long numSamples);
-		virtual void runThread2(long startIndex,long numSamples);
-		virtual void runThread3(long startIndex,long numSamples);
-		virtual void runThread4(long startIndex,long numSamples);
-		virtual void runThread5(long startIndex,long numSamples);
-		virtual void runThread6(long startIndex,long numSamples);
-		virtual void runThread7(long startIndex,long numSamples);
-		virtual void runThread8(long startIndex,long numSamples);
-		virtual void runThread9(long startIndex,long numSamples);
-		virtual void runThread10(long startIndex,long numSamples);
-		virtual void runThread11(long startIndex,long numSamples);
-		virtual void runThread12(long startIndex,long numSamples);
-		virtual void runThread13(long startIndex,long numSamples);
-		virtual void runThread14(long startIndex,long numSamples);
-		virtual void runThread15(long startIndex,long numSamples);
-		virtual void runThread16(long startIndex,long numSamples);
+		ThreadBuffers<gr_complex> laneBuffers;
+		FFTFilterCCC fftFilter;
+		int engine;
 
     public:
 		FIRFilterCCC_MT(int nthreads);
@@ -267,7 +615,294 @@ namespace gr {
 
 		// OutputBuffer here should be at least numSamples/decimation in length
 		virtual long filterNdec(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation);
+
+		// Multi-threaded polyphase decimator.  numSamples is the decimated count, as with filterNdec.
+		virtual long filterNdecPolyphase(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation);
+
+		virtual void setTaps(const std::vector<gr_complex>& newTaps);
+
+		// Swaps tap state with a standby filter (see Filter::swapTaps)
+		void swapTaps(FIRFilterCCC_MT &other);
+
+		// Builds anything the taps need ahead of the first call (the FFT tap transform).
+		// Used on standby filters so the swap itself is cheap.
+		void prepareTaps();
+
+		// Engine selection for useFFT()
+		inline void setEngine(int newEngine) { engine = newEngine; };
+		inline int getEngine() { return engine; };
+
+		// True if the overlap-save engine should be used for a numSamples (decimated) call
+		bool useFFT(long numSamples, int decimation=1);
+
+		// Multi-threaded overlap-save filter.  numSamples is the decimated count, as with filterNdec.
+		virtual long filterNFFT(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples, int decimation=1);
     };
+
+	/*
+	 * FIR Filter - complex int16 (sc16) inputs, int16 taps, int32 accumulation.
+	 * Output is saturated to int16 after an arithmetic right shift (outputShift, default 15 for Q15 taps)
+	 * or converted to float with floatScale (default 1/2^30, so Q15 taps on full-scale int16 input give +/-1.0).
+	 * The accumulator is not widened: keep the sum of |taps| under 65536 to avoid wrapping.
+	 *
+	 * I and Q are filtered as separate planes with pairs of taps per int16 multiply-add
+	 * (blockedAccumulateS16).  Decimation is polyphase: each input phase is a lane filtered
+	 * with its own sub-filter, and the phases are summed in the accumulator.
+	 */
+    class FIRFilterSCS {
+	protected:
+		std::vector<int16_t> d_taps;	// reversed
+		long numTaps;
+		int outputShift;
+		float floatScale;
+
+		// Per-phase tap pairs for phaseDecimation
+		int phaseDecimation;
+		std::vector<std::vector<int32_t> > phaseTapPairs;
+		std::vector<long> phaseLength;
+		long maxPhaseLength;
+
+		ThreadBuffers<int32_t> workspaces;
+
+		void buildPhases();
+
+		// Fills accI/accQ with the int32 sums for numOutputs outputs.  pairsI/pairsQ are scratch.
+		void accumulate(int32_t *accI, int32_t *accQ, const lv_16sc_t *inputBuffer, long numOutputs,
+				int32_t *pairsI, int32_t *pairsQ);
+
+		int32_t *getWorkspace(int32_t *workspace, long numOutputs);
+
+	public:
+		FIRFilterSCS();
+		FIRFilterSCS(const std::vector<int16_t>& newTaps);
+		virtual ~FIRFilterSCS() {};
+
+		virtual void setTaps(const std::vector<int16_t>& newTaps);
+		// For compatibility
+		inline virtual void set_taps(const std::vector<int16_t>& newTaps) { setTaps(newTaps); };
+		virtual std::vector<int16_t> getTaps() const;
+		inline virtual std::vector<int16_t> taps() const { return getTaps();};
+		inline virtual long ntaps() { return numTaps;};
+
+		inline void setShift(int shift) { outputShift = std::max(0,std::min(31,shift)); };
+		inline int getShift() const { return outputShift; };
+		inline void setFloatScale(float scale) { floatScale = scale; };
+		inline float getFloatScale() const { return floatScale; };
+
+		// Builds the polyphase sub-filters for decimation.  filterNdec does this itself when the
+		// decimation changes, but not thread-safely, so multi-threaded callers do it first.
+		void setDecimation(int decimation);
+		inline int getDecimation() const { return phaseDecimation; };
+
+		// int32 words of workspace a numOutputs call needs
+		inline long workspaceSize(long numOutputs) { return 4*numOutputs + 2*(maxPhaseLength + 1); };
+
+		// inputBuffer must hold numOutputs*decimation + ntaps - 1 samples.  workspace (workspaceSize(numOutputs) words)
+		// may be NULL to use an internal buffer.  Returns numOutputs.
+		virtual long filterNdec(lv_16sc_t *outputBuffer, const lv_16sc_t *inputBuffer, long numOutputs, int decimation, int32_t *workspace=NULL);
+		virtual long filterNdec(gr_complex *outputBuffer, const lv_16sc_t *inputBuffer, long numOutputs, int decimation, int32_t *workspace=NULL);
+
+		inline long filterN(lv_16sc_t *outputBuffer, const lv_16sc_t *inputBuffer, long numOutputs) { return filterNdec(outputBuffer,inputBuffer,numOutputs,1); };
+		inline long filterN(gr_complex *outputBuffer, const lv_16sc_t *inputBuffer, long numOutputs) { return filterNdec(outputBuffer,inputBuffer,numOutputs,1); };
+    };
+
+    class FIRFilterSCS_MT:public MTBase, public FIRFilterSCS {
+    public:
+    	FIRFilterSCS_MT(int nthreads);
+    	FIRFilterSCS_MT(const std::vector<int16_t>& newTaps, int nthreads);
+		virtual ~FIRFilterSCS_MT() {};
+
+		// Same as FIRFilterSCS::filterNdec with the outputs split across the threads
+		virtual long filterNdec(lv_16sc_t *outputBuffer, const lv_16sc_t *inputBuffer, long numOutputs, int decimation, int32_t *workspace=NULL);
+		virtual long filterNdec(gr_complex *outputBuffer, const lv_16sc_t *inputBuffer, long numOutputs, int decimation, int32_t *workspace=NULL);
+    };
+
+    // --------------------------------------------------
+    // Multi-threaded polyphase interpolator / rational resampler
+    // --------------------------------------------------
+	/*
+	 * Prototype taps (designed at interpolation * input rate) are split into
+	 * interpolation sub-filters: sub-filter k holds taps k, k+I, k+2I, ... zero-padded
+	 * to a common length.  Output n is taken from input (phaseCounter + n*D) / I using
+	 * sub-filter (phaseCounter + n*D) % I, so every output is independent and
+	 * the outputs can be split freely across threads.
+	 */
+    template<class io_type, class tap_type>
+	class PolyphaseResampler:public MTBase {
+	protected:
+		int d_interpolation;
+		int d_decimation;
+		long subFilterLength;
+		std::vector<tap_type> d_prototypeTaps;
+		std::vector<Filter<io_type,tap_type> *> subFilters;
+
+		void clearSubFilters();
+
+	public:
+		PolyphaseResampler(int interpolation, int decimation, const std::vector<tap_type>& newTaps, int nthreads);
+		virtual ~PolyphaseResampler();
+
+		virtual void setTaps(const std::vector<tap_type>& newTaps);
+		// For compatibility
+		inline virtual void set_taps(const std::vector<tap_type>& newTaps) { setTaps(newTaps); };
+		inline virtual std::vector<tap_type> taps() const { return d_prototypeTaps; };
+
+		// Number of input samples each output spans (history required)
+		inline virtual long ntaps() { return subFilterLength; };
+
+		inline int interpolation() { return d_interpolation; };
+		inline int decimation() { return d_decimation; };
+
+		// Number of outputs that can be produced from numInputs input samples (not counting history)
+		long outputsAvailable(long numInputs, long phaseCounter);
+
+		// inputBuffer must include ntaps()-1 samples of history.
+		// phaseCounter is the starting sub-filter index (0..interpolation-1).  Returns numOutputs.
+		virtual long filterN(io_type *outputBuffer, const io_type *inputBuffer, long numOutputs, long phaseCounter=0);
+	};
+
+    typedef PolyphaseResampler<gr_complex,float> PolyphaseResamplerCCF;
+    typedef PolyphaseResampler<float,float> PolyphaseResamplerFFF;
+    typedef PolyphaseResampler<gr_complex,gr_complex> PolyphaseResamplerCCC;
+
+	/*
+	 * Half-band decimate-by-2, optionally cascaded.
+	 * A half-band filter (odd length, center index c) has every tap at c +/- 2, 4, 6, ... equal to 0,
+	 * so apart from the center tap all the nonzero taps fall on one input phase.  Each stage pulls
+	 * that phase into a lane buffer and runs only the nonzero taps over it with a FIRFilterCCF/FFF
+	 * (blocked, and folded since half-band taps are symmetric), then adds the center tap term.
+	 *
+	 * With numStages > 1 the same taps are applied numStages times for a total decimation of 2^numStages.
+	 * Each thread runs its share of the final outputs through every stage in its own buffers, so there
+	 * are no intermediate block buffers and no synchronization between stages.
+	 */
+    template<class io_type, class lane_filter_type>
+	class HalfBandDecimator:public MTBase {
+	protected:
+		std::vector<float> d_taps;
+		long numTaps;
+		int numStages;
+
+		// Nonzero taps off center, applied to input phase lanePhase
+		lane_filter_type laneFilter;
+		int lanePhase;
+		long laneTaps;
+
+		// Reversed-tap index of the center tap and its value
+		long centerIndex;
+		float centerTap;
+
+		ThreadBuffers<io_type> laneBuffers;
+		// Stage outputs feeding the next stage, two per thread used alternately
+		ThreadBuffers<io_type> stageBuffers[2];
+
+		// One decimate-by-2 stage.  inputBuffer must hold 2*numOutputs + ntaps - 2 samples.
+		void filterStage(io_type *outputBuffer, const io_type *inputBuffer, long numOutputs, io_type *lane);
+
+	public:
+		HalfBandDecimator(const std::vector<float>& newTaps, int stages, int nthreads);
+		virtual ~HalfBandDecimator() {};
+
+		// True if taps are odd-length and every second tap out from the center is 0 (relative to the largest tap).
+		static bool isHalfBand(const std::vector<float>& taps);
+
+		// Throws std::invalid_argument if the taps are not half-band
+		virtual void setTaps(const std::vector<float>& newTaps);
+		// For compatibility
+		inline virtual void set_taps(const std::vector<float>& newTaps) { setTaps(newTaps); };
+		inline virtual std::vector<float> taps() const { return d_taps; };
+		inline virtual long ntaps() { return numTaps; };
+
+		inline int stages() { return numStages; };
+		inline int decimation() { return 1 << numStages; };
+
+		// Extra input samples numOutputs outputs need beyond decimation()*numOutputs (history() - 1 in GR terms)
+		inline long historyRequired() { return (numTaps - 2) * (decimation() - 1); };
+
+		// inputBuffer must hold decimation()*numOutputs + historyRequired() samples.  Returns numOutputs.
+		virtual long filterN(io_type *outputBuffer, const io_type *inputBuffer, long numOutputs);
+	};
+
+    typedef HalfBandDecimator<gr_complex,FIRFilterCCF> HalfBandDecimatorCCF;
+    typedef HalfBandDecimator<float,FIRFilterFFF> HalfBandDecimatorFFF;
+
+    // ------------------------------------------------
+    // Fused filter chain
+    // ------------------------------------------------
+#define LFAST_CHAIN_FIR 0
+#define LFAST_CHAIN_ROTATOR 1
+#define LFAST_CHAIN_AGC 2
+
+    // Default tile: about this many samples in the largest per-thread stage buffer (two buffers fit in L2)
+#define LFAST_CHAIN_TILE_SAMPLES 16384
+
+	/*
+	 * Several stages fused into one call, complex data.
+	 * FIR (optionally decimating) and rotator stages run back to back on one tile of outputs at a time,
+	 * with the tiles spread across the threads, so the samples between stages stay in that thread's
+	 * cache instead of going through a block buffer per stage.  Each tile recomputes the history it
+	 * needs from the chain input, so tiles are independent.
+	 * AGC gain carries from sample to sample, so AGC stages have to come after all the FIR/rotator stages
+	 * and run over the final (decimated) output once the tiles are done.
+	 */
+	class FilterChainCCF:public MTBase {
+	protected:
+		struct ChainStage {
+			int type;
+			FIRFilterCCF *fir;
+			int decimation;
+			// Samples at this stage's input per final output
+			long rate;
+			// Rotator: radians per sample, and the phase of the first new sample of the next call
+			double phaseIncrement;
+			double phase;
+			// AGC
+			float agcRate;
+			float reference;
+			float initialGain;
+			float gain;
+			float maxGain;
+		};
+
+		std::vector<ChainStage> stages;
+		// Stages [0, numTileStages) are FIR/rotator stages, the rest AGC
+		int numTileStages;
+		long totalDecimation;
+		long history;
+		long tileSize;
+
+		// Stage outputs within a tile, two per thread used alternately
+		ThreadBuffers<gr_complex> tileBuffers[2];
+		ThreadBuffers<long> tileGeometry;
+
+		void updateGeometry();
+		void filterTile(gr_complex *outputBuffer, const gr_complex *inputBuffer, long firstOutput, long numOutputs, int threadIndex);
+
+	public:
+		FilterChainCCF(int nthreads=4);
+		virtual ~FilterChainCCF();
+
+		// Stages apply in the order they're added.  FIR and rotator stages throw std::invalid_argument after an AGC stage.
+		void addFIR(const std::vector<float>& taps, int decimation=1);
+		// phaseIncrement is in radians per sample at that point in the chain
+		void addRotator(double phaseIncrement);
+		void addAGC(float rate, float reference, float gain, float maxGain);
+
+		inline int numStages() { return stages.size(); };
+		inline long decimation() { return totalDecimation; };
+		// Extra input samples numOutputs outputs need beyond decimation()*numOutputs (history() - 1 in GR terms)
+		inline long historyRequired() { return history; };
+
+		// Outputs per tile.  0 (the default) sizes tiles from LFAST_CHAIN_TILE_SAMPLES.
+		inline void setTileSize(long outputs) { tileSize = outputs; };
+
+		// Rotator phases back to 0 and AGC gains back to their initial values
+		void reset();
+
+		// inputBuffer must hold decimation()*numOutputs + historyRequired() samples.  Returns numOutputs.
+		virtual long filterN(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numOutputs);
+	};
+
   } // end lfast
 } // end gr
 
@@ -0,0 +1,79 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+#include <gnuradio/io_signature.h>
+#include "freq_shift_impl.h"
+#include <volk/volk.h>
+
+namespace gr {
+namespace lfast {
+
+freq_shift::sptr freq_shift::make(double phase_inc, int mode)
+{
+	return gnuradio::make_block_sptr<freq_shift_impl>(phase_inc, mode);
+}
+
+/*
+ * The private constructor
+ */
+freq_shift_impl::freq_shift_impl(double phase_inc, int mode)
+: gr::sync_block("freq_shift",
+		io_signature::make(1, 1, sizeof(gr_complex)),
+		io_signature::make(1, 1, sizeof(gr_complex))),
+		d_nco(phase_inc, mode)
+{
+	const int alignment_multiple =
+			volk_get_alignment() / sizeof(gr_complex);
+	set_alignment(std::max(1, alignment_multiple));
+}
+
+/*
+ * Our virtual destructor.
+ */
+freq_shift_impl::~freq_shift_impl()
+{
+}
+
+void freq_shift_impl::set_phase_inc(double phase_inc) {
+	gr::thread::scoped_lock l(d_setlock);
+	d_nco.setPhaseIncrement(phase_inc);
+}
+
+void freq_shift_impl::set_mode(int mode) {
+	gr::thread::scoped_lock l(d_setlock);
+	d_nco.setMode(mode);
+}
+
+int
+freq_shift_impl::work(int noutput_items,
+		gr_vector_const_void_star &input_items,
+		gr_vector_void_star &output_items)
+{
+	gr::thread::scoped_lock l(d_setlock);
+
+	const gr_complex *in = (const gr_complex*)input_items[0];
+	gr_complex *out = (gr_complex*)output_items[0];
+
+	d_nco.rotate(out, in, noutput_items);
+
+	return noutput_items;
+}
+} /* namespace lfast */
+} /* namespace gr */
+
@@ -0,0 +1,55 @@
+/* -*- c++ -*- */
+/* 
+ * Copyright 2017 ghostop14.
+ * 
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ * 
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_LFAST_FREQ_SHIFT_IMPL_H
+#define INCLUDED_LFAST_FREQ_SHIFT_IMPL_H
+
+#include <lfast/freq_shift.h>
+#include "nco_lfast.h"
+
+namespace gr {
+  namespace lfast {
+
+    class freq_shift_impl : public freq_shift
+    {
+     private:
+      NCO d_nco;
+
+     public:
+      freq_shift_impl(double phase_inc, int mode);
+      ~freq_shift_impl();
+
+      void set_phase_inc(double phase_inc);
+      double phase_inc() const { return d_nco.getPhaseIncrement(); }
+
+      void set_mode(int mode);
+      int mode() const { return d_nco.getMode(); }
+
+      // Where all the action really happens
+      int work(int noutput_items,
+         gr_vector_const_void_star &input_items,
+         gr_vector_void_star &output_items);
+    };
+
+  } // namespace lfast
+} // namespace gr
+
+#endif /* INCLUDED_LFAST_FREQ_SHIFT_IMPL_H */
+
@@ -0,0 +1,103 @@
+/*
+ * mirrored_buffer_lfast.cc
+ *
+ *      Copyright 2019, Michael Piscopo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "mirrored_buffer_lfast.h"
+
+#include <stdexcept>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+namespace gr {
+  namespace lfast {
+	static int createSharedMemory() {
+		int fd = -1;
+
+#if defined(__linux__) && defined(SYS_memfd_create)
+		fd = syscall(SYS_memfd_create,"lfast_mirror",0);
+#endif
+
+		if (fd < 0) {
+			char path[] = "/tmp/lfast_mirror_XXXXXX";
+
+			fd = mkstemp(path);
+
+			if (fd >= 0)
+				unlink(path);
+		}
+
+		return fd;
+	}
+
+	MirroredMemory::MirroredMemory(size_t minSize, size_t granularity) {
+		size_t pageSize = sysconf(_SC_PAGESIZE);
+
+		if (minSize < 1)
+			minSize = 1;
+
+		if (granularity < 1)
+			granularity = 1;
+
+		d_size = ((minSize + pageSize - 1) / pageSize) * pageSize;
+
+		while (d_size % granularity)
+			d_size += pageSize;
+
+		d_base = NULL;
+
+		int fd = createSharedMemory();
+
+		if (fd < 0)
+			throw std::runtime_error("MirroredMemory: unable to create shared memory");
+
+		if (ftruncate(fd,d_size) != 0) {
+			close(fd);
+			throw std::runtime_error("MirroredMemory: unable to size shared memory");
+		}
+
+		// Reserve both halves first so nothing else can land in the second half between the two maps
+		void *reserved = mmap(NULL,2*d_size,PROT_NONE,MAP_PRIVATE | MAP_ANONYMOUS,-1,0);
+
+		if (reserved == MAP_FAILED) {
+			close(fd);
+			throw std::runtime_error("MirroredMemory: unable to reserve address space");
+		}
+
+		char *base = (char *)reserved;
+
+		if ((mmap(base,d_size,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_FIXED,fd,0) == MAP_FAILED) ||
+			(mmap(base + d_size,d_size,PROT_READ | PROT_WRITE,MAP_SHARED | MAP_FIXED,fd,0) == MAP_FAILED)) {
+			munmap(reserved,2*d_size);
+			close(fd);
+			throw std::runtime_error("MirroredMemory: unable to map mirrored memory");
+		}
+
+		// The mappings keep the memory alive
+		close(fd);
+
+		d_base = base;
+	}
+
+	MirroredMemory::~MirroredMemory() {
+		if (d_base)
+			munmap(d_base,2*d_size);
+	}
+  } // end lfast
+} // end gr
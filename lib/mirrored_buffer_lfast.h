@@ -0,0 +1,67 @@
+/*
+ * mirrored_buffer_lfast.h
+ *
+ *      Copyright 2019, Michael Piscopo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIB_MIRRORED_BUFFER_LFAST_H_
+#define LIB_MIRRORED_BUFFER_LFAST_H_
+
+#include <stddef.h>
+
+namespace gr {
+  namespace lfast {
+	/*
+	 * Double-mapped ring memory: one shared memory object (memfd, or an unlinked temp file where
+	 * memfd isn't available) mapped twice back to back, so bytes [size, 2*size) alias [0, size).
+	 * Any window of up to size bytes starting anywhere in [0, size) is contiguous, so a ring
+	 * never needs a wrap-around copy.  Page aligned.  Throws std::runtime_error if the mapping fails.
+	 */
+	class MirroredMemory {
+	protected:
+		char *d_base;
+		size_t d_size;
+
+	public:
+		// size is rounded up to a multiple of the page size and of granularity
+		MirroredMemory(size_t minSize, size_t granularity=1);
+		virtual ~MirroredMemory();
+
+		inline void *data() const { return d_base; };
+		inline size_t size() const { return d_size; };
+	};
+
+	/*
+	 * Ring of T on mirrored memory.  at(index) is contiguous for capacity() items for any index,
+	 * and indexes wrap, so the last n items before a write position are always one window.
+	 * New memory is zeroed.
+	 */
+	template<class T>
+	class MirroredBuffer:public MirroredMemory {
+	protected:
+		size_t d_capacity;
+
+	public:
+		MirroredBuffer(size_t minItems):MirroredMemory(minItems*sizeof(T),sizeof(T)) { d_capacity = d_size / sizeof(T); };
+		virtual ~MirroredBuffer() {};
+
+		inline size_t capacity() const { return d_capacity; };
+		inline T *at(size_t index) const { return (T *)d_base + (index % d_capacity); };
+	};
+  } // end lfast
+} // end gr
+
+#endif /* LIB_MIRRORED_BUFFER_LFAST_H_ */
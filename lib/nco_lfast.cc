@@ -0,0 +1,314 @@
+/*
+ * nco_lfast.cc
+ *
+ *      Copyright 2019, Michael Piscopo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "nco_lfast.h"
+#include "fir_blocked_lfast.h"
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LFAST_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+// Polynomial modes compute this many phases from one start phase (keeps k*increment small in float)
+#define LFAST_NCO_POLY_RUN 32
+
+namespace gr {
+  namespace lfast {
+	template <int accuracy> static void sinCosN(float *sinOut, float *cosOut, const float *phase, long numSamples) {
+		for (long i=0;i<numSamples;i++)
+			ncoSinCos<accuracy>(phase[i],sinOut[i],cosOut[i]);
+	}
+
+	template <int accuracy> static void rotateN(float *out, const float *in, float startPhase, float phaseIncrement, long numSamples) {
+		float s,c,i_r,i_i;
+
+		for (long i=0;i<numSamples;i++) {
+			ncoSinCos<accuracy>(startPhase + (float)i * phaseIncrement,s,c);
+
+			if (in) {
+				i_r = in[2*i];
+				i_i = in[2*i+1];
+				out[2*i] = i_r * c - i_i * s;
+				out[2*i+1] = i_r * s + i_i * c;
+			}
+			else {
+				out[2*i] = c;
+				out[2*i+1] = s;
+			}
+		}
+	}
+
+#if defined(LFAST_X86_KERNELS)
+	// Same steps as ncoSinCos, 8 phases at a time
+	template <int accuracy> __attribute__((target("avx2,fma")))
+	static inline void sinCos_avx2(__m256 phase, __m256 &sinOut, __m256 &cosOut) {
+		const __m256i one = _mm256_set1_epi32(1);
+		const __m256i two = _mm256_set1_epi32(2);
+
+		__m256i q = _mm256_cvtps_epi32(_mm256_mul_ps(phase,_mm256_set1_ps(0.63661977236758134308f)));
+		__m256 qf = _mm256_cvtepi32_ps(q);
+
+		__m256 r = _mm256_fnmadd_ps(qf,_mm256_set1_ps(1.5703125f),phase);
+		r = _mm256_fnmadd_ps(qf,_mm256_set1_ps(4.837512969970703125e-4f),r);
+		r = _mm256_fnmadd_ps(qf,_mm256_set1_ps(7.54978995489188216e-8f),r);
+
+		__m256 r2 = _mm256_mul_ps(r,r);
+		__m256 s,c;
+
+		if (accuracy == LFAST_NCO_FAST) {
+			s = _mm256_fmadd_ps(r2,_mm256_set1_ps(8.3333333333e-3f),_mm256_set1_ps(-1.6666666666e-1f));
+			s = _mm256_fmadd_ps(_mm256_mul_ps(r,r2),s,r);
+			c = _mm256_fmadd_ps(r2,_mm256_set1_ps(4.1666666666e-2f),_mm256_set1_ps(-0.5f));
+			c = _mm256_fmadd_ps(r2,c,_mm256_set1_ps(1.0f));
+		}
+		else {
+			s = _mm256_fmadd_ps(r2,_mm256_set1_ps(-1.9515295891e-4f),_mm256_set1_ps(8.3321608736e-3f));
+			s = _mm256_fmadd_ps(r2,s,_mm256_set1_ps(-1.6666654611e-1f));
+			s = _mm256_fmadd_ps(_mm256_mul_ps(r,r2),s,r);
+			c = _mm256_fmadd_ps(r2,_mm256_set1_ps(2.443315711809948e-5f),_mm256_set1_ps(-1.388731625493765e-3f));
+			c = _mm256_fmadd_ps(r2,c,_mm256_set1_ps(4.166664568298827e-2f));
+			c = _mm256_fmadd_ps(_mm256_mul_ps(r2,r2),c,_mm256_fnmadd_ps(_mm256_set1_ps(0.5f),r2,_mm256_set1_ps(1.0f)));
+		}
+
+		__m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q,one),one));
+		__m256 sq = _mm256_blendv_ps(s,c,swap);
+		__m256 cq = _mm256_blendv_ps(c,s,swap);
+
+		// (q & 2) << 30 is the sign bit
+		__m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q,two),30));
+		__m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q,one),two),30));
+
+		sinOut = _mm256_xor_ps(sq,sinSign);
+		cosOut = _mm256_xor_ps(cq,cosSign);
+	}
+
+	template <int accuracy> __attribute__((target("avx2,fma")))
+	static long rotate_avx2(float *out, const float *in, float startPhase, float phaseIncrement, long numSamples) {
+		long blocked = (numSamples / 8) * 8;
+
+		const __m256i loIndex = _mm256_setr_epi32(0,0,1,1,2,2,3,3);
+		const __m256i hiIndex = _mm256_setr_epi32(4,4,5,5,6,6,7,7);
+		const __m256 vIncrement = _mm256_set1_ps(phaseIncrement);
+		const __m256 vStart = _mm256_set1_ps(startPhase);
+		__m256 k = _mm256_setr_ps(0.0f,1.0f,2.0f,3.0f,4.0f,5.0f,6.0f,7.0f);
+		const __m256 eight = _mm256_set1_ps(8.0f);
+		__m256 s,c;
+
+		for (long i=0;i<blocked;i+=8) {
+			sinCos_avx2<accuracy>(_mm256_fmadd_ps(k,vIncrement,vStart),s,c);
+			k = _mm256_add_ps(k,eight);
+
+			if (in) {
+				__m256 a = _mm256_loadu_ps(&in[2*i]);
+				__m256 b = _mm256_loadu_ps(&in[2*i+8]);
+
+				// (r*c - i*s, i*c + r*s) with the swapped pair in the second product
+				a = _mm256_fmaddsub_ps(a,_mm256_permutevar8x32_ps(c,loIndex),
+						_mm256_mul_ps(_mm256_permute_ps(a,0xB1),_mm256_permutevar8x32_ps(s,loIndex)));
+				b = _mm256_fmaddsub_ps(b,_mm256_permutevar8x32_ps(c,hiIndex),
+						_mm256_mul_ps(_mm256_permute_ps(b,0xB1),_mm256_permutevar8x32_ps(s,hiIndex)));
+
+				_mm256_storeu_ps(&out[2*i],a);
+				_mm256_storeu_ps(&out[2*i+8],b);
+			}
+			else {
+				__m256 lo = _mm256_unpacklo_ps(c,s);
+				__m256 hi = _mm256_unpackhi_ps(c,s);
+
+				_mm256_storeu_ps(&out[2*i],_mm256_permute2f128_ps(lo,hi,0x20));
+				_mm256_storeu_ps(&out[2*i+8],_mm256_permute2f128_ps(lo,hi,0x31));
+			}
+		}
+
+		return blocked;
+	}
+#endif
+
+	template <int accuracy> static void rotateDispatch(float *out, const float *in, float startPhase, float phaseIncrement, long numSamples) {
+		long done = 0;
+
+#if defined(LFAST_X86_KERNELS)
+		if (blockedKernelLevel() >= LFAST_KERNEL_AVX2)
+			done = rotate_avx2<accuracy>(out,in,startPhase,phaseIncrement,numSamples);
+#endif
+
+		if (done < numSamples)
+			rotateN<accuracy>(&out[2*done],in ? &in[2*done] : NULL,startPhase + (float)done * phaseIncrement,phaseIncrement,numSamples - done);
+	}
+
+	void ncoSinCosN(float *sinOut, float *cosOut, const float *phase, long numSamples, int accuracy) {
+		if (accuracy == LFAST_NCO_FAST)
+			sinCosN<LFAST_NCO_FAST>(sinOut,cosOut,phase,numSamples);
+		else
+			sinCosN<LFAST_NCO_ACCURATE>(sinOut,cosOut,phase,numSamples);
+	}
+
+	void ncoRampN(gr_complex *outputBuffer, float startPhase, float phaseIncrement, long numSamples, int accuracy) {
+		if (accuracy == LFAST_NCO_FAST)
+			rotateDispatch<LFAST_NCO_FAST>((float *)outputBuffer,NULL,startPhase,phaseIncrement,numSamples);
+		else
+			rotateDispatch<LFAST_NCO_ACCURATE>((float *)outputBuffer,NULL,startPhase,phaseIncrement,numSamples);
+	}
+
+	void ncoRotateN(gr_complex *outputBuffer, const gr_complex *inputBuffer, float startPhase, float phaseIncrement,
+			long numSamples, int accuracy) {
+		if (accuracy == LFAST_NCO_FAST)
+			rotateDispatch<LFAST_NCO_FAST>((float *)outputBuffer,(const float *)inputBuffer,startPhase,phaseIncrement,numSamples);
+		else
+			rotateDispatch<LFAST_NCO_ACCURATE>((float *)outputBuffer,(const float *)inputBuffer,startPhase,phaseIncrement,numSamples);
+	}
+
+	// ---------------------------------------------------------
+	// NCO
+	// ---------------------------------------------------------
+	static double wrapPhase(double phase) {
+		phase = fmod(phase + M_PI,2.0*M_PI);
+
+		if (phase < 0.0)
+			phase += 2.0*M_PI;
+
+		return phase - M_PI;
+	}
+
+	NCO::NCO(double phaseIncrement, int mode) {
+		phase = 0.0;
+		this->phaseIncrement = phaseIncrement;
+		setMode(mode);
+	}
+
+	void NCO::setPhase(double newPhase) {
+		phase = wrapPhase(newPhase);
+	}
+
+	void NCO::setMode(int newMode) {
+		if (newMode == LFAST_NCO_RECURSIVE || newMode == LFAST_NCO_FAST)
+			mode = newMode;
+		else
+			mode = LFAST_NCO_ACCURATE;
+	}
+
+	void NCO::rotate(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples) {
+		if (mode == LFAST_NCO_RECURSIVE)
+			rotateRecursive(outputBuffer,inputBuffer,numSamples);
+		else
+			rotatePolynomial(outputBuffer,inputBuffer,numSamples);
+
+		phase = wrapPhase(phase + (double)numSamples * phaseIncrement);
+	}
+
+	void NCO::rotatePolynomial(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples) {
+		// Small increments in float relative to a start kept in double
+		float increment = (float)wrapPhase(phaseIncrement);
+		double runPhase = phase;
+		double runIncrement = (double)LFAST_NCO_POLY_RUN * phaseIncrement;
+
+		for (long start=0;start<numSamples;start += LFAST_NCO_POLY_RUN) {
+			long len = numSamples - start;
+
+			if (len > LFAST_NCO_POLY_RUN)
+				len = LFAST_NCO_POLY_RUN;
+
+			if (inputBuffer)
+				ncoRotateN(&outputBuffer[start],&inputBuffer[start],(float)runPhase,increment,len,mode);
+			else
+				ncoRampN(&outputBuffer[start],(float)runPhase,increment,len,mode);
+
+			// Nearest-multiple wrap, no fmod in the loop
+			runPhase += runIncrement;
+			double turns = runPhase * (0.5/M_PI);
+			runPhase -= 2.0*M_PI * (double)(long)(turns + (turns >= 0.0 ? 0.5 : -0.5));
+		}
+	}
+
+	template <bool hasInput> static void recursiveN(float *out, const float *in, double phase, double phaseIncrement, long numSamples) {
+		float laneReal[LFAST_NCO_LANES];
+		float laneImag[LFAST_NCO_LANES];
+		float o_r,o_i,i_r,i_i,l_r;
+
+		// All lanes step by LFAST_NCO_LANES samples
+		float stepReal = (float)cos((double)LFAST_NCO_LANES * phaseIncrement);
+		float stepImag = (float)sin((double)LFAST_NCO_LANES * phaseIncrement);
+
+		for (long start=0;start<numSamples;start += LFAST_NCO_RENORM_SAMPLES) {
+			long len = numSamples - start;
+
+			if (len > LFAST_NCO_RENORM_SAMPLES)
+				len = LFAST_NCO_RENORM_SAMPLES;
+
+			// Re-seed every lane from the exact phase
+			double startPhase = phase + (double)start * phaseIncrement;
+
+			for (int k=0;k<LFAST_NCO_LANES;k++) {
+				laneReal[k] = (float)cos(startPhase + (double)k * phaseIncrement);
+				laneImag[k] = (float)sin(startPhase + (double)k * phaseIncrement);
+			}
+
+			long fullGroups = (len / LFAST_NCO_LANES) * LFAST_NCO_LANES;
+			long i;
+
+			for (i=0;i<fullGroups;i += LFAST_NCO_LANES) {
+				float *o = &out[2*(start+i)];
+				const float *inGroup = hasInput ? &in[2*(start+i)] : NULL;
+
+				for (int k=0;k<LFAST_NCO_LANES;k++) {
+					if (hasInput) {
+						i_r = inGroup[2*k];
+						i_i = inGroup[2*k+1];
+						o_r = i_r * laneReal[k] - i_i * laneImag[k];
+						o_i = i_r * laneImag[k] + i_i * laneReal[k];
+					}
+					else {
+						o_r = laneReal[k];
+						o_i = laneImag[k];
+					}
+
+					o[2*k] = o_r;
+					o[2*k+1] = o_i;
+
+					l_r = laneReal[k] * stepReal - laneImag[k] * stepImag;
+					laneImag[k] = laneReal[k] * stepImag + laneImag[k] * stepReal;
+					laneReal[k] = l_r;
+				}
+			}
+
+			// Partial group at the end
+			for (int k=0;i<len;i++,k++) {
+				if (hasInput) {
+					i_r = in[2*(start+i)];
+					i_i = in[2*(start+i)+1];
+					out[2*(start+i)] = i_r * laneReal[k] - i_i * laneImag[k];
+					out[2*(start+i)+1] = i_r * laneImag[k] + i_i * laneReal[k];
+				}
+				else {
+					out[2*(start+i)] = laneReal[k];
+					out[2*(start+i)+1] = laneImag[k];
+				}
+			}
+		}
+	}
+
+	void NCO::rotateRecursive(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples) {
+		if (inputBuffer)
+			recursiveN<true>((float *)outputBuffer,(const float *)inputBuffer,phase,phaseIncrement,numSamples);
+		else
+			recursiveN<false>((float *)outputBuffer,NULL,phase,phaseIncrement,numSamples);
+	}
+  } // end lfast
+} // end gr
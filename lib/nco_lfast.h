@@ -0,0 +1,124 @@
+/*
+ * nco_lfast.h
+ *
+ *      Copyright 2019, Michael Piscopo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIB_NCO_LFAST_H_
+#define LIB_NCO_LFAST_H_
+
+#include <gnuradio/gr_complex.h>
+
+// NCO modes.  The polynomial modes are also the accuracy levels of ncoSinCos.
+// Recursive: per-sample phasor multiply, re-seeded from the exact phase every LFAST_NCO_RENORM_SAMPLES
+#define LFAST_NCO_RECURSIVE 0
+// Polynomial sincos, max error about 3e-4
+#define LFAST_NCO_FAST 1
+// Polynomial sincos, max error about 1e-7 (float resolution)
+#define LFAST_NCO_ACCURATE 2
+
+#define LFAST_NCO_RENORM_SAMPLES 512
+// Recursive mode runs this many independent phasors, one per SIMD lane
+#define LFAST_NCO_LANES 8
+
+namespace gr {
+  namespace lfast {
+	/*
+	 * sin and cos of phase with no libm calls and no branches, cheap enough to inline into per-sample loops.
+	 * The phase is reduced by the nearest multiple of pi/2 (3-part Cody-Waite) to [-pi/4, pi/4],
+	 * where a polynomial is evaluated, then the quadrant picks the signs.
+	 * The reduction is accurate for |phase| up to a few thousand radians.
+	 */
+	template <int accuracy> inline void ncoSinCos(float phase, float &sinOut, float &cosOut) {
+		float x = phase * 0.63661977236758134308f;	// 2/pi
+		int q = (int)(x + (x >= 0.0f ? 0.5f : -0.5f));
+		float qf = (float)q;
+
+		float r = phase - qf * 1.5703125f;
+		r = r - qf * 4.837512969970703125e-4f;
+		r = r - qf * 7.54978995489188216e-8f;
+
+		float r2 = r * r;
+		float s,c;
+
+		if (accuracy == LFAST_NCO_FAST) {
+			s = r + r * r2 * (-1.6666666666e-1f + r2 * 8.3333333333e-3f);
+			c = 1.0f + r2 * (-0.5f + r2 * 4.1666666666e-2f);
+		}
+		else {
+			// cephes sinf/cosf coefficients
+			s = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+			c = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+		}
+
+		// Odd quadrants swap sin and cos, quadrants 2 and 3 negate sin, 1 and 2 negate cos
+		float sq = (q & 1) ? c : s;
+		float cq = (q & 1) ? s : c;
+
+		sinOut = (q & 2) ? -sq : sq;
+		cosOut = ((q + 1) & 2) ? -cq : cq;
+	}
+
+	// Batched sin/cos of an array of phases (accuracy LFAST_NCO_FAST or LFAST_NCO_ACCURATE)
+	void ncoSinCosN(float *sinOut, float *cosOut, const float *phase, long numSamples, int accuracy);
+
+	// out[k] = exp(j*(startPhase + k*phaseIncrement)) with the polynomial sincos (8 at a time with AVX2)
+	void ncoRampN(gr_complex *outputBuffer, float startPhase, float phaseIncrement, long numSamples, int accuracy);
+
+	// out[k] = in[k] * exp(j*(startPhase + k*phaseIncrement)) with the polynomial sincos
+	void ncoRotateN(gr_complex *outputBuffer, const gr_complex *inputBuffer, float startPhase, float phaseIncrement,
+			long numSamples, int accuracy);
+
+	/*
+	 * Phase accumulator NCO.  The phase is kept in double and wrapped to [-pi, pi) once per call,
+	 * so it doesn't drift no matter how long it runs.
+	 *
+	 * In the polynomial modes the phases of each 32-sample run are start + k*increment in float.
+	 * The recursive mode multiplies LFAST_NCO_LANES phasors (one per SIMD lane, each stepping by
+	 * LFAST_NCO_LANES*increment) and re-seeds them from the accumulated phase every
+	 * LFAST_NCO_RENORM_SAMPLES samples, so magnitude and phase errors never build up.
+	 */
+	class NCO {
+	protected:
+		double phase;
+		double phaseIncrement;
+		int mode;
+
+		void rotateRecursive(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples);
+		void rotatePolynomial(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples);
+
+	public:
+		NCO(double phaseIncrement=0.0, int mode=LFAST_NCO_ACCURATE);
+		virtual ~NCO() {};
+
+		void setPhaseIncrement(double newIncrement) { phaseIncrement = newIncrement; };
+		double getPhaseIncrement() const { return phaseIncrement; };
+
+		void setPhase(double newPhase);
+		double getPhase() const { return phase; };
+
+		// Unknown modes fall back to LFAST_NCO_ACCURATE
+		void setMode(int newMode);
+		int getMode() const { return mode; };
+
+		// out[k] = in[k] * exp(j*phase), phase advancing by the increment each sample.
+		// inputBuffer may be NULL to just generate the oscillator.
+		void rotate(gr_complex *outputBuffer, const gr_complex *inputBuffer, long numSamples);
+	};
+  } // end lfast
+} // end gr
+
+#endif /* LIB_NCO_LFAST_H_ */
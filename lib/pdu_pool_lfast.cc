@@ -0,0 +1,62 @@
+/*
+ * pdu_pool_lfast.cc
+ *
+ *      Copyright 2019, Michael Piscopo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "pdu_pool_lfast.h"
+
+namespace gr {
+  namespace lfast {
+	PDUPool::PDUPool(size_t maxPDUs) {
+		this->maxPDUs = maxPDUs;
+		pool.reserve(maxPDUs);
+	}
+
+	pmt::pmt_t PDUPool::getPDU(pmt::pmt_t meta, size_t numSamples, gr_complex *&samples) {
+		size_t len;
+		int freeSlot = -1;
+
+		for (size_t i=0;i<pool.size();i++) {
+			if (!isFree(pool[i]))
+				continue;
+
+			if (pmt::length(pool[i].samples) == numSamples) {
+				pmt::set_car(pool[i].pdu,meta);
+				samples = pmt::c32vector_writable_elements(pool[i].samples,len);
+				return pool[i].pdu;
+			}
+
+			if (freeSlot < 0)
+				freeSlot = i;
+		}
+
+		PooledPDU entry;
+		entry.samples = pmt::make_c32vector(numSamples,gr_complex(0.0f,0.0f));
+		entry.pdu = pmt::cons(meta,entry.samples);
+		samples = pmt::c32vector_writable_elements(entry.samples,len);
+
+		// Take over a free slot holding a different size, or grow the pool.
+		// When every slot is in flight the PDU just isn't pooled.
+		if (freeSlot >= 0)
+			pool[freeSlot] = entry;
+		else if (pool.size() < maxPDUs)
+			pool.push_back(entry);
+
+		return entry.pdu;
+	}
+  } // end lfast
+} // end gr
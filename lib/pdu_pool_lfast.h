@@ -0,0 +1,66 @@
+/*
+ * pdu_pool_lfast.h
+ *
+ *      Copyright 2019, Michael Piscopo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef LIB_PDU_POOL_LFAST_H_
+#define LIB_PDU_POOL_LFAST_H_
+
+#include <gnuradio/gr_complex.h>
+#include <pmt/pmt.h>
+#include <vector>
+
+#define LFAST_PDU_POOL_SIZE 16
+
+namespace gr {
+  namespace lfast {
+	/*
+	 * Pool of complex PDUs (a pair of metadata and a c32vector) for blocks that publish PDUs at high rates.
+	 * A pooled PDU is handed out again once nothing outside the pool references it any more
+	 * (downstream blocks have dropped both the pair and the vector), so with steady burst sizes
+	 * publishing a PDU costs no heap allocation: the vector is written in place and the pair's car
+	 * is pointed at the new metadata.
+	 *
+	 * pmt vectors can't be resized, so a PDU is only reused for the same number of samples.
+	 * Not thread safe: use one pool per publishing thread.
+	 */
+	class PDUPool {
+	protected:
+		struct PooledPDU {
+			pmt::pmt_t pdu;
+			pmt::pmt_t samples;
+		};
+
+		std::vector<PooledPDU> pool;
+		size_t maxPDUs;
+
+		bool isFree(const PooledPDU &entry) const {
+			// Only referenced by the pool entry (and, for the vector, the pair's cdr)
+			return (entry.pdu.use_count() == 1) && (entry.samples.use_count() == 2);
+		};
+
+	public:
+		PDUPool(size_t maxPDUs=LFAST_PDU_POOL_SIZE);
+		virtual ~PDUPool() {};
+
+		// Returns a PDU (meta . c32vector[numSamples]) and a writable pointer to its samples
+		pmt::pmt_t getPDU(pmt::pmt_t meta, size_t numSamples, gr_complex *&samples);
+	};
+  } // end lfast
+} // end gr
+
+#endif /* LIB_PDU_POOL_LFAST_H_ */
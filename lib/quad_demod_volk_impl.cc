@@ -707,6 +707,9 @@ quad_demod_volk_impl::quad_demod_volk_impl(float gain)
 	set_alignment(std::max(1, alignment_multiple));
 
 	set_history(2); // we need to look at the previous value
+
+	d_tmp = NULL;
+	d_tmp_size = 0;
 }
 
 /*
@@ -714,6 +717,22 @@ quad_demod_volk_impl::quad_demod_volk_impl(float gain)
  */
 quad_demod_volk_impl::~quad_demod_volk_impl()
 {
+	if (d_tmp)
+		volk_free(d_tmp);
+}
+
+gr_complex *
+quad_demod_volk_impl::tmp_buffer(int noutput_items)
+{
+	if (d_tmp_size < noutput_items) {
+		if (d_tmp)
+			volk_free(d_tmp);
+
+		d_tmp = (gr_complex *)volk_malloc(noutput_items*sizeof(gr_complex),volk_get_alignment());
+		d_tmp_size = noutput_items;
+	}
+
+	return d_tmp;
 }
 
 int
@@ -741,10 +760,10 @@ quad_demod_volk_impl::work_test(int noutput_items,
 	gr_complex *in = (gr_complex*)input_items[0];
 	float *out = (float*)output_items[0];
 
-	std::vector<gr_complex> tmp(noutput_items);
-	volk_32fc_x2_multiply_conjugate_32fc(&tmp[0], &in[1], &in[0], noutput_items);
+	gr_complex *tmp = tmp_buffer(noutput_items);
+	volk_32fc_x2_multiply_conjugate_32fc(tmp, &in[1], &in[0], noutput_items);
 
-	volk_32fc_s32f_atan2_32f(&out[0],&tmp[0],d_inv_gain,noutput_items);
+	volk_32fc_s32f_atan2_32f(&out[0],tmp,d_inv_gain,noutput_items);
 
 	return noutput_items;
 }
@@ -759,10 +778,10 @@ quad_demod_volk_impl::work(int noutput_items,
 	gr_complex *in = (gr_complex*)input_items[0];
 	float *out = (float*)output_items[0];
 
-	std::vector<gr_complex> tmp(noutput_items);
-	volk_32fc_x2_multiply_conjugate_32fc(&tmp[0], &in[1], &in[0], noutput_items);
+	gr_complex *tmp = tmp_buffer(noutput_items);
+	volk_32fc_x2_multiply_conjugate_32fc(tmp, &in[1], &in[0], noutput_items);
 
-	volk_32fc_s32f_atan2_32f(&out[0],&tmp[0],d_inv_gain,noutput_items);
+	volk_32fc_s32f_atan2_32f(&out[0],tmp,d_inv_gain,noutput_items);
 	//volk_32fc_s32f_atan2_32f(&out[0],&tmp[0],1.0,noutput_items);
 	//volk_32f_s32f_multiply_32f(out,out,d_gain,noutput_items);
 
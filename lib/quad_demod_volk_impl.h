@@ -690,6 +690,12 @@ namespace gr {
     	float d_gain;
     	float d_inv_gain;
 
+    	// Conjugate-product scratch kept across calls rather than allocated (and zeroed) in every work call
+    	gr_complex *d_tmp;
+    	int d_tmp_size;
+
+    	gr_complex *tmp_buffer(int noutput_items);
+
      public:
       quad_demod_volk_impl(float gain);
       ~quad_demod_volk_impl();
@@ -27,18 +27,23 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <cmath>
 #include <boost/algorithm/string/replace.hpp>
 
 #include <chrono>
 #include "costas2_impl.h"
 #include "costas4_impl.h"
+#include "costas_fast_impl.h"
 #include "agc_fast_impl.h"
+#include "agc2_fast_impl.h"
+#include "agc3_fast_impl.h"
 #include "CC2F2ByteVector_impl.h"
 #include "nlog10volk_impl.h"
 #include "quad_demod_volk_impl.h"
 #include "MTFIRFilterCCF_impl.h"
 
 #include "fir_filter_lfast.h"
+#include "nco_lfast.h"
 
 int largeBlockSize=8192;
 int ntaps=241;
@@ -188,6 +193,184 @@ void timeFilter() {
 	delete test;
 }
 
+void timeSymmetricFilter() {
+	std::cout << "----------------------------------------------------------" << std::endl;
+
+	int localblocksize=largeBlockSize;
+
+	std::cout << "Testing symmetric-tap (folded) FIR filter with complex data and float taps with " << ntaps << " taps, " <<
+			localblocksize << " samples..." << std::endl;
+
+	// Hamming-windowed sinc low pass, symmetric like the firdes designs
+	std::vector<float> filtertaps;
+	float center = (ntaps - 1) / 2.0;
+
+	for (int i=0;i<ntaps;i++) {
+		float x = (float)i - center;
+		float sinc = (x == 0.0) ? 1.0 : sin(0.2 * M_PI * x) / (0.2 * M_PI * x);
+		float window = 0.54 - 0.46 * cos(2.0 * M_PI * i / (ntaps > 1 ? ntaps - 1 : 1));
+		filtertaps.push_back(0.2 * sinc * window);
+	}
+
+	FIRFilterCCF *test = new FIRFilterCCF(filtertaps);
+
+	if (test->getTapSymmetry() != LFAST_TAPS_SYMMETRIC) {
+		std::cout << "ERROR: taps were not detected as symmetric." << std::endl;
+		delete test;
+		return;
+	}
+
+	int i;
+	std::chrono::time_point<std::chrono::steady_clock> start, end;
+	std::chrono::duration<double> elapsed_seconds = end-start;
+
+	// Need to give it the tail buffer.  volk_malloc so the aligned kernels see aligned buffers like GR's.
+	int requiredSize=localblocksize + ntaps;
+	size_t alignment = volk_get_alignment();
+	gr_complex *inputItems = (gr_complex *)volk_malloc(requiredSize*sizeof(gr_complex),alignment);
+	gr_complex *outputItems = (gr_complex *)volk_malloc(localblocksize*sizeof(gr_complex),alignment);
+	gr_complex *outputItems2 = (gr_complex *)volk_malloc(localblocksize*sizeof(gr_complex),alignment);
+
+	for (i=0;i<requiredSize;i++) {
+		inputItems[i] = gr_complex(cos(0.01*i),sin(0.013*i));
+	}
+
+	int iterations = 100;
+	float elapsed_time,throughput_original,throughput;
+
+	// Unfolded
+	test->setSymmetryMode(LFAST_SYMMETRY_OFF);
+	test->filterN(outputItems,inputItems,localblocksize);
+
+	start = std::chrono::steady_clock::now();
+	// make iterations calls to get average.
+	for (i=0;i<iterations;i++) {
+		test->filterN(outputItems,inputItems,localblocksize);
+	}
+	end = std::chrono::steady_clock::now();
+
+	elapsed_seconds = end-start;
+
+	elapsed_time = elapsed_seconds.count()/(float)iterations;
+	throughput_original = localblocksize / elapsed_time;
+
+	std::cout << "Unfolded Run Time:   " << std::fixed << std::setw(11)
+    << std::setprecision(6) << elapsed_time << " s  (" << throughput_original << " sps)" << std::endl;
+
+	// Folded
+	test->setSymmetryMode(LFAST_SYMMETRY_AUTO);
+	test->filterN(outputItems2,inputItems,localblocksize);
+
+	start = std::chrono::steady_clock::now();
+	// make iterations calls to get average.
+	for (i=0;i<iterations;i++) {
+		test->filterN(outputItems2,inputItems,localblocksize);
+	}
+	end = std::chrono::steady_clock::now();
+
+	elapsed_seconds = end-start;
+
+	elapsed_time = elapsed_seconds.count()/(float)iterations;
+	throughput = localblocksize / elapsed_time;
+
+	std::cout << "Folded Run Time:   " << std::fixed << std::setw(11)
+    << std::setprecision(6) << elapsed_time << " s  (" << throughput << " sps)" << std::endl;
+
+	float maxError = 0.0;
+
+	for (i=0;i<localblocksize;i++) {
+		maxError = std::max(maxError,std::abs(outputItems[i] - outputItems2[i]));
+	}
+
+	std::cout << "Max difference from unfolded output: " << std::scientific << maxError <<
+			(maxError < 1e-4 ? " (OK)" : " (ERROR)") << std::endl;
+
+	float faster = (throughput / throughput_original - 1) * 100.0;
+	std::cout << "Speedup:   " << std::fixed << std::setw(11)
+    << std::setprecision(2) << faster << "% faster" << std::endl << std::endl;
+
+	volk_free(inputItems);
+	volk_free(outputItems);
+	volk_free(outputItems2);
+
+	delete test;
+}
+
+void timeChunkBalance() {
+	std::cout << "----------------------------------------------------------" << std::endl;
+
+	int localblocksize=largeBlockSize;
+
+	std::cout << "Testing multi-threaded FIR chunk scheduling with " << ntaps << " taps, " <<
+			localblocksize << " samples, " << maxThreads << " threads..." << std::endl;
+
+	std::vector<float> filtertaps;
+
+	for (int i=0;i<ntaps;i++) {
+		filtertaps.push_back(1.0 / (float)ntaps);
+	}
+
+	FIRFilterCCF_MT *test = new FIRFilterCCF_MT(filtertaps,maxThreads);
+	test->setEngine(LFAST_FILTER_ENGINE_DIRECT);
+
+	int i;
+	std::chrono::time_point<std::chrono::steady_clock> start, end;
+	std::chrono::duration<double> elapsed_seconds = end-start;
+
+	int requiredSize=localblocksize + ntaps;
+	size_t alignment = volk_get_alignment();
+	gr_complex *inputItems = (gr_complex *)volk_malloc(requiredSize*sizeof(gr_complex),alignment);
+	gr_complex *outputItems = (gr_complex *)volk_malloc(localblocksize*sizeof(gr_complex),alignment);
+
+	for (i=0;i<requiredSize;i++) {
+		inputItems[i] = gr_complex(0.5f,0.25f);
+	}
+
+	int iterations = 100;
+	float elapsed_time,throughput;
+
+	const long chunkModes[2] = {LFAST_CHUNK_STATIC, LFAST_CHUNK_AUTO};
+	const char *chunkNames[2] = {"One block per thread", "Small chunks"};
+
+	for (int mode=0;mode<2;mode++) {
+		test->setChunkSize(chunkModes[mode]);
+		test->filterN(outputItems,inputItems,localblocksize);
+		test->resetChunkCounts();
+
+		start = std::chrono::steady_clock::now();
+		// make iterations calls to get average.
+		for (i=0;i<iterations;i++) {
+			test->filterN(outputItems,inputItems,localblocksize);
+		}
+		end = std::chrono::steady_clock::now();
+
+		elapsed_seconds = end-start;
+
+		elapsed_time = elapsed_seconds.count()/(float)iterations;
+		throughput = localblocksize / elapsed_time;
+
+		std::cout << chunkNames[mode] << " Run Time:   " << std::fixed << std::setw(11)
+	    << std::setprecision(6) << elapsed_time << " s  (" << throughput << " sps)" << std::endl;
+
+		std::vector<long> counts = test->getChunkCounts();
+
+		std::cout << "Chunks per thread:";
+
+		for (size_t t=0;t<counts.size();t++) {
+			std::cout << " " << counts[t];
+		}
+
+		std::cout << std::endl;
+	}
+
+	std::cout << std::endl;
+
+	volk_free(inputItems);
+	volk_free(outputItems);
+
+	delete test;
+}
+
 void timeCC2Vector() {
 	std::cout << "----------------------------------------------------------" << std::endl;
 
@@ -688,6 +871,227 @@ void timeCostasLoop4() {
 	delete test;
 }
 
+void timeCostasLoop8() {
+	int localblocksize=largeBlockSize;
+
+	std::cout << "Testing 8th order (8PSK) templated Costas Loop with " << localblocksize << " samples..." << std::endl;
+
+	costas_fast_impl<8> *test;
+	test = new costas_fast_impl<8>(0.00199);
+
+	int i;
+	std::chrono::time_point<std::chrono::steady_clock> start, end;
+	std::chrono::duration<double> elapsed_seconds = end-start;
+
+	std::vector<gr_complex> inputItems;
+	std::vector<gr_complex> outputItems;
+	std::vector<const void *> inputPointers;
+	std::vector<void *> outputPointers;
+
+	for (i=0;i<localblocksize;i++) {
+		inputItems.push_back(gr_complex(1.0f,0.5f));
+		outputItems.push_back(gr_complex(0.0f,0.0f));
+	}
+
+	inputPointers.push_back((const void *)&inputItems[0]);
+	outputPointers.push_back((void *)&outputItems[0]);
+
+	int noutputitems;
+	int iterations = 100;
+	float elapsed_time,throughput_original,throughput;
+
+	noutputitems = test->work_original(localblocksize,inputPointers,outputPointers);
+
+	start = std::chrono::steady_clock::now();
+	// make iterations calls to get average.
+	for (i=0;i<iterations;i++) {
+		noutputitems = test->work_original(localblocksize,inputPointers,outputPointers);
+	}
+	end = std::chrono::steady_clock::now();
+
+	elapsed_seconds = end-start;
+
+	elapsed_time = elapsed_seconds.count()/(float)iterations;
+	throughput_original = localblocksize / elapsed_time;
+
+	std::cout << "Original Code Run Time:   " << std::fixed << std::setw(11)
+    << std::setprecision(6) << elapsed_time << " s  (" << throughput_original << " sps)" << std::endl;
+
+	// New Code
+	// -----------------------------
+	start = std::chrono::steady_clock::now();
+	// make iterations calls to get average.
+	for (i=0;i<iterations;i++) {
+		noutputitems = test->work(localblocksize,inputPointers,outputPointers);
+	}
+	end = std::chrono::steady_clock::now();
+
+	elapsed_seconds = end-start;
+
+	elapsed_time = elapsed_seconds.count()/(float)iterations;
+	throughput = localblocksize / elapsed_time;
+
+	std::cout << "LFAST Code Run Time:   " << std::fixed << std::setw(11)
+    << std::setprecision(6) << elapsed_time << " s  (" << throughput << " sps)" << std::endl;
+
+	float faster = (throughput / throughput_original - 1) * 100.0;
+	std::cout << "Speedup:   " << std::fixed << std::setw(11)
+    << std::setprecision(2) << faster << "% faster" << std::endl << std::endl;
+
+	delete test;
+}
+
+// Times work_original (the plain kernel loop) against work for one of the attack/decay AGCs
+template <class AGC> void timeAGCWork(AGC *test, std::vector<gr_complex> &inputItems) {
+	int localblocksize=inputItems.size();
+	int i;
+	std::chrono::time_point<std::chrono::steady_clock> start, end;
+	std::chrono::duration<double> elapsed_seconds = end-start;
+
+	std::vector<gr_complex> outputItems(localblocksize);
+	std::vector<const void *> inputPointers;
+	std::vector<void *> outputPointers;
+
+	inputPointers.push_back((const void *)&inputItems[0]);
+	outputPointers.push_back((void *)&outputItems[0]);
+
+	int iterations = 100;
+	float elapsed_time,throughput_original,throughput;
+
+	test->work_original(localblocksize,inputPointers,outputPointers);
+
+	start = std::chrono::steady_clock::now();
+	// make iterations calls to get average.
+	for (i=0;i<iterations;i++) {
+		test->work_original(localblocksize,inputPointers,outputPointers);
+	}
+	end = std::chrono::steady_clock::now();
+
+	elapsed_seconds = end-start;
+
+	elapsed_time = elapsed_seconds.count()/(float)iterations;
+	throughput_original = localblocksize / elapsed_time;
+
+	std::cout << "Original Code Run Time:   " << std::fixed << std::setw(11)
+    << std::setprecision(6) << elapsed_time << " s  (" << throughput_original << " sps)" << std::endl;
+
+	start = std::chrono::steady_clock::now();
+	// make iterations calls to get average.
+	for (i=0;i<iterations;i++) {
+		test->work(localblocksize,inputPointers,outputPointers);
+	}
+	end = std::chrono::steady_clock::now();
+
+	elapsed_seconds = end-start;
+
+	elapsed_time = elapsed_seconds.count()/(float)iterations;
+	throughput = localblocksize / elapsed_time;
+
+	std::cout << "LFAST Code Run Time:   " << std::fixed << std::setw(11)
+    << std::setprecision(6) << elapsed_time << " s  (" << throughput << " sps)" << std::endl;
+
+	float faster = (throughput / throughput_original - 1) * 100.0;
+	std::cout << "Speedup:   " << std::fixed << std::setw(11)
+    << std::setprecision(2) << faster << "% faster" << std::endl << std::endl;
+}
+
+void timeAttackDecayAGC() {
+	std::cout << "----------------------------------------------------------" << std::endl;
+
+	int localblocksize=largeBlockSize;
+
+	// Bursts: alternating quiet and loud stretches so both the attack and decay rates get used
+	std::vector<gr_complex> inputItems;
+
+	for (int i=0;i<localblocksize;i++) {
+		float level = ((i / 1024) % 2) ? 2.0f : 0.05f;
+		inputItems.push_back(gr_complex(level*cosf(0.01f*i),level*sinf(0.01f*i)));
+	}
+
+	std::cout << "Testing AGC2 (attack/decay) with " << localblocksize << " samples..." << std::endl;
+
+	agc2_fast_impl *test2 = new agc2_fast_impl(0.1,0.01,1.0,1.0);
+	test2->set_max_gain(4000.0);
+	timeAGCWork(test2,inputItems);
+	delete test2;
+
+	std::cout << "Testing AGC3 (level tracking) with " << localblocksize << " samples..." << std::endl;
+
+	agc3_fast_impl *test3 = new agc3_fast_impl(0.1,0.01,1.0,1.0,1);
+	test3->set_max_gain(4000.0);
+	timeAGCWork(test3,inputItems);
+	delete test3;
+
+	std::cout << "Testing AGC3 (level tracking, update every 16 samples) with " << localblocksize << " samples..." << std::endl;
+
+	test3 = new agc3_fast_impl(0.1,0.01,1.0,1.0,16);
+	test3->set_max_gain(4000.0);
+	timeAGCWork(test3,inputItems);
+	delete test3;
+}
+
+void timeFreqShift() {
+	std::cout << "----------------------------------------------------------" << std::endl;
+
+	int localblocksize=largeBlockSize;
+
+	std::cout << "Testing frequency shift with " << localblocksize << " samples..." << std::endl;
+
+	std::vector<gr_complex> inputItems;
+	std::vector<gr_complex> outputItems(localblocksize);
+
+	for (int i=0;i<localblocksize;i++) {
+		inputItems.push_back(gr_complex(1.0f,0.5f));
+	}
+
+	int i;
+	int iterations = 100;
+	double phaseIncrement = 2.0*M_PI*0.01;
+	float elapsed_time,throughput_original,throughput;
+	std::chrono::time_point<std::chrono::steady_clock> start, end;
+	std::chrono::duration<double> elapsed_seconds;
+
+	// Stock rotator_cc path
+	lv_32fc_t phase = lv_cmake(1.0f,0.0f);
+	lv_32fc_t phaseInc = std::polar(1.0f,(float)phaseIncrement);
+
+	start = std::chrono::steady_clock::now();
+	for (i=0;i<iterations;i++) {
+		volk_32fc_s32fc_x2_rotator_32fc(&outputItems[0],&inputItems[0],phaseInc,&phase,localblocksize);
+	}
+	end = std::chrono::steady_clock::now();
+
+	elapsed_seconds = end-start;
+	elapsed_time = elapsed_seconds.count()/(float)iterations;
+	throughput_original = localblocksize / elapsed_time;
+
+	std::cout << "Original Code (volk rotator) Run Time:   " << std::fixed << std::setw(11)
+    << std::setprecision(6) << elapsed_time << " s  (" << throughput_original << " sps)" << std::endl;
+
+	const char *modeNames[] = {"recursive","fast polynomial","accurate polynomial"};
+
+	for (int mode=LFAST_NCO_RECURSIVE;mode<=LFAST_NCO_ACCURATE;mode++) {
+		NCO nco(phaseIncrement,mode);
+
+		start = std::chrono::steady_clock::now();
+		for (i=0;i<iterations;i++) {
+			nco.rotate(&outputItems[0],&inputItems[0],localblocksize);
+		}
+		end = std::chrono::steady_clock::now();
+
+		elapsed_seconds = end-start;
+		elapsed_time = elapsed_seconds.count()/(float)iterations;
+		throughput = localblocksize / elapsed_time;
+
+		std::cout << "LFAST NCO (" << modeNames[mode] << ") Run Time:   " << std::fixed << std::setw(11)
+	    << std::setprecision(6) << elapsed_time << " s  (" << throughput << " sps)" << std::endl;
+
+		float faster = (throughput / throughput_original - 1) * 100.0;
+		std::cout << "Speedup:   " << std::fixed << std::setw(11)
+	    << std::setprecision(2) << faster << "% faster" << std::endl << std::endl;
+	}
+}
+
 void printHelp() {
 	std::cout << std::endl;
 //			std::cout << "Usage: [<test buffer size>] [--gpu] [--cpu] [--accel] [--any]" << std::endl;
@@ -762,10 +1166,15 @@ main (int argc, char **argv)
 
 	timeCostasLoop2();
 	timeCostasLoop4();
+	timeCostasLoop8();
 	timeAGC();
+	timeAttackDecayAGC();
+	timeFreqShift();
 	timeCC2Vector();
 	timeLog10();
 	timeFilter();
+	timeSymmetricFilter();
+	timeChunkBalance();
 
 	// This just turned out to be slower even specifying other architectures in .volk/volk_profile
 	// timeQuadDemod();
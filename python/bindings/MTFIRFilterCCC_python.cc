@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(MTFIRFilterCCC.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(f8f9d735ffa6fb4e174073ee0642fc6b)                     */
+/* BINDTOOL_HEADER_FILE_HASH(e35d351d211faf7f1f4fdb82678c0ab4)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -40,6 +40,9 @@ void bind_MTFIRFilterCCC(py::module& m)
            py::arg("decimation"),
            py::arg("taps"),
            py::arg("nthreads"),
+           py::arg("polyphase") = false,
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
            D(MTFIRFilterCCC,make)
         )
         
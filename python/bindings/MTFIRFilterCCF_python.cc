@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(MTFIRFilterCCF.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(983a0f4b4b48b4bb69ea58b2df23d301)                     */
+/* BINDTOOL_HEADER_FILE_HASH(536506bc264bf1bcf57b11df7fa8db8c)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -40,6 +40,9 @@ void bind_MTFIRFilterCCF(py::module& m)
            py::arg("decimation"),
            py::arg("taps"),
            py::arg("nthreads"),
+           py::arg("polyphase") = false,
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
            D(MTFIRFilterCCF,make)
         )
         
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(MTFIRFilterFF.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(16914d02353fea6618bea70cc00b3e3d)                     */
+/* BINDTOOL_HEADER_FILE_HASH(535ef6cc1ea62f4c90c625e4485959f7)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -40,6 +40,9 @@ void bind_MTFIRFilterFF(py::module& m)
            py::arg("decimation"),
            py::arg("taps"),
            py::arg("nthreads"),
+           py::arg("polyphase") = false,
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
            D(MTFIRFilterFF,make)
         )
         
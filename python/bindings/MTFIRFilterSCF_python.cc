@@ -0,0 +1,70 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTFIRFilterSCF.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(4e24436b7dc284ce44a1054e3da80445)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTFIRFilterSCF.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTFIRFilterSCF_pydoc.h>
+
+void bind_MTFIRFilterSCF(py::module& m)
+{
+
+    using MTFIRFilterSCF    = ::gr::lfast::MTFIRFilterSCF;
+
+
+    py::class_<MTFIRFilterSCF, gr::sync_decimator,
+        std::shared_ptr<MTFIRFilterSCF>>(m, "MTFIRFilterSCF", D(MTFIRFilterSCF))
+
+        .def(py::init(&MTFIRFilterSCF::make),
+           py::arg("decimation"),
+           py::arg("taps"),
+           py::arg("nthreads"),
+           py::arg("scale"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTFIRFilterSCF,make)
+        )
+        
+
+
+
+
+        
+        .def("set_taps",&MTFIRFilterSCF::set_taps,       
+            py::arg("taps"),
+            D(MTFIRFilterSCF,set_taps)
+        )
+
+
+        
+        .def("taps",&MTFIRFilterSCF::taps,       
+            D(MTFIRFilterSCF,taps)
+        )
+
+        ;
+
+
+
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTFIRFilterSCS.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(790437a91dedc7f4067568f487825ea7)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTFIRFilterSCS.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTFIRFilterSCS_pydoc.h>
+
+void bind_MTFIRFilterSCS(py::module& m)
+{
+
+    using MTFIRFilterSCS    = ::gr::lfast::MTFIRFilterSCS;
+
+
+    py::class_<MTFIRFilterSCS, gr::sync_decimator,
+        std::shared_ptr<MTFIRFilterSCS>>(m, "MTFIRFilterSCS", D(MTFIRFilterSCS))
+
+        .def(py::init(&MTFIRFilterSCS::make),
+           py::arg("decimation"),
+           py::arg("taps"),
+           py::arg("nthreads"),
+           py::arg("shift"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTFIRFilterSCS,make)
+        )
+        
+
+
+
+
+        
+        .def("set_taps",&MTFIRFilterSCS::set_taps,       
+            py::arg("taps"),
+            D(MTFIRFilterSCS,set_taps)
+        )
+
+
+        
+        .def("taps",&MTFIRFilterSCS::taps,       
+            D(MTFIRFilterSCS,taps)
+        )
+
+        ;
+
+
+
+
+}
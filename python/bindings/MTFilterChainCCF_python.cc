@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTFilterChainCCF.h)                                              */
+/* BINDTOOL_HEADER_FILE_HASH(934524bd40cf2507fb7c696c27961068)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTFilterChainCCF.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTFilterChainCCF_pydoc.h>
+
+void bind_MTFilterChainCCF(py::module& m)
+{
+
+    using MTFilterChainCCF    = ::gr::lfast::MTFilterChainCCF;
+
+
+    py::class_<MTFilterChainCCF, gr::sync_decimator,
+        std::shared_ptr<MTFilterChainCCF>>(m, "MTFilterChainCCF", D(MTFilterChainCCF))
+
+        .def(py::init(&MTFilterChainCCF::make),
+           py::arg("nthreads"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTFilterChainCCF,make)
+        )
+        
+
+
+
+
+        
+        .def("add_fir",&MTFilterChainCCF::add_fir,       
+            py::arg("taps"),
+            py::arg("decimation"),
+            D(MTFilterChainCCF,add_fir)
+        )
+
+
+        
+        .def("add_rotator",&MTFilterChainCCF::add_rotator,       
+            py::arg("phase_inc"),
+            D(MTFilterChainCCF,add_rotator)
+        )
+
+
+        
+        .def("add_agc",&MTFilterChainCCF::add_agc,       
+            py::arg("rate"),
+            py::arg("reference"),
+            py::arg("gain"),
+            py::arg("max_gain"),
+            D(MTFilterChainCCF,add_agc)
+        )
+
+
+        
+        .def("num_stages",&MTFilterChainCCF::num_stages,       
+            D(MTFilterChainCCF,num_stages)
+        )
+
+        ;
+
+
+
+
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTHalfBandDecimatorCCF.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(e0cea245dfa92ae75b3b7c83c9410aef)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTHalfBandDecimatorCCF.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTHalfBandDecimatorCCF_pydoc.h>
+
+void bind_MTHalfBandDecimatorCCF(py::module& m)
+{
+
+    using MTHalfBandDecimatorCCF    = ::gr::lfast::MTHalfBandDecimatorCCF;
+
+
+    py::class_<MTHalfBandDecimatorCCF, gr::sync_decimator,
+        std::shared_ptr<MTHalfBandDecimatorCCF>>(m, "MTHalfBandDecimatorCCF", D(MTHalfBandDecimatorCCF))
+
+        .def(py::init(&MTHalfBandDecimatorCCF::make),
+           py::arg("taps"),
+           py::arg("stages"),
+           py::arg("nthreads"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTHalfBandDecimatorCCF,make)
+        )
+        
+
+
+
+
+        
+        .def("set_taps",&MTHalfBandDecimatorCCF::set_taps,       
+            py::arg("taps"),
+            D(MTHalfBandDecimatorCCF,set_taps)
+        )
+
+
+        
+        .def("taps",&MTHalfBandDecimatorCCF::taps,       
+            D(MTHalfBandDecimatorCCF,taps)
+        )
+
+        ;
+
+
+
+
+}
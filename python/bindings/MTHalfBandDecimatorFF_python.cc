@@ -0,0 +1,69 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTHalfBandDecimatorFF.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(ce98b0cd52b81db125237daa40086017)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTHalfBandDecimatorFF.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTHalfBandDecimatorFF_pydoc.h>
+
+void bind_MTHalfBandDecimatorFF(py::module& m)
+{
+
+    using MTHalfBandDecimatorFF    = ::gr::lfast::MTHalfBandDecimatorFF;
+
+
+    py::class_<MTHalfBandDecimatorFF, gr::sync_decimator,
+        std::shared_ptr<MTHalfBandDecimatorFF>>(m, "MTHalfBandDecimatorFF", D(MTHalfBandDecimatorFF))
+
+        .def(py::init(&MTHalfBandDecimatorFF::make),
+           py::arg("taps"),
+           py::arg("stages"),
+           py::arg("nthreads"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTHalfBandDecimatorFF,make)
+        )
+        
+
+
+
+
+        
+        .def("set_taps",&MTHalfBandDecimatorFF::set_taps,       
+            py::arg("taps"),
+            D(MTHalfBandDecimatorFF,set_taps)
+        )
+
+
+        
+        .def("taps",&MTHalfBandDecimatorFF::taps,       
+            D(MTHalfBandDecimatorFF,taps)
+        )
+
+        ;
+
+
+
+
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTInterpFIRFilterCCC.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(689ed57757f04197ac8852018bed28bb)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTInterpFIRFilterCCC.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTInterpFIRFilterCCC_pydoc.h>
+
+void bind_MTInterpFIRFilterCCC(py::module& m)
+{
+
+    using MTInterpFIRFilterCCC    = ::gr::lfast::MTInterpFIRFilterCCC;
+
+
+    py::class_<MTInterpFIRFilterCCC, gr::sync_interpolator,
+        std::shared_ptr<MTInterpFIRFilterCCC>>(m, "MTInterpFIRFilterCCC", D(MTInterpFIRFilterCCC))
+
+        .def(py::init(&MTInterpFIRFilterCCC::make),
+           py::arg("interpolation"),
+           py::arg("taps"),
+           py::arg("nthreads"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTInterpFIRFilterCCC,make)
+        )
+        
+
+
+
+
+        
+        .def("set_taps",&MTInterpFIRFilterCCC::set_taps,       
+            py::arg("taps"),
+            D(MTInterpFIRFilterCCC,set_taps)
+        )
+
+
+        
+        .def("taps",&MTInterpFIRFilterCCC::taps,       
+            D(MTInterpFIRFilterCCC,taps)
+        )
+
+        ;
+
+
+
+
+}
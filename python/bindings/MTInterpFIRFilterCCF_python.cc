@@ -0,0 +1,69 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTInterpFIRFilterCCF.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(67966a125eeac1c1996d757712dc8a20)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTInterpFIRFilterCCF.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTInterpFIRFilterCCF_pydoc.h>
+
+void bind_MTInterpFIRFilterCCF(py::module& m)
+{
+
+    using MTInterpFIRFilterCCF    = ::gr::lfast::MTInterpFIRFilterCCF;
+
+
+    py::class_<MTInterpFIRFilterCCF, gr::sync_interpolator,
+        std::shared_ptr<MTInterpFIRFilterCCF>>(m, "MTInterpFIRFilterCCF", D(MTInterpFIRFilterCCF))
+
+        .def(py::init(&MTInterpFIRFilterCCF::make),
+           py::arg("interpolation"),
+           py::arg("taps"),
+           py::arg("nthreads"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTInterpFIRFilterCCF,make)
+        )
+        
+
+
+
+
+        
+        .def("set_taps",&MTInterpFIRFilterCCF::set_taps,       
+            py::arg("taps"),
+            D(MTInterpFIRFilterCCF,set_taps)
+        )
+
+
+        
+        .def("taps",&MTInterpFIRFilterCCF::taps,       
+            D(MTInterpFIRFilterCCF,taps)
+        )
+
+        ;
+
+
+
+
+}
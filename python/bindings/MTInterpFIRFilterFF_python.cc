@@ -0,0 +1,69 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTInterpFIRFilterFF.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(a91fa229f8b771e14c5e0a9ee8961c0c)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTInterpFIRFilterFF.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTInterpFIRFilterFF_pydoc.h>
+
+void bind_MTInterpFIRFilterFF(py::module& m)
+{
+
+    using MTInterpFIRFilterFF    = ::gr::lfast::MTInterpFIRFilterFF;
+
+
+    py::class_<MTInterpFIRFilterFF, gr::sync_interpolator,
+        std::shared_ptr<MTInterpFIRFilterFF>>(m, "MTInterpFIRFilterFF", D(MTInterpFIRFilterFF))
+
+        .def(py::init(&MTInterpFIRFilterFF::make),
+           py::arg("interpolation"),
+           py::arg("taps"),
+           py::arg("nthreads"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTInterpFIRFilterFF,make)
+        )
+        
+
+
+
+
+        
+        .def("set_taps",&MTInterpFIRFilterFF::set_taps,       
+            py::arg("taps"),
+            D(MTInterpFIRFilterFF,set_taps)
+        )
+
+
+        
+        .def("taps",&MTInterpFIRFilterFF::taps,       
+            D(MTInterpFIRFilterFF,taps)
+        )
+
+        ;
+
+
+
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTRationalResamplerCCC.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(f15f6a0dfcd93a8d5a0b5fc1357096ae)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTRationalResamplerCCC.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTRationalResamplerCCC_pydoc.h>
+
+void bind_MTRationalResamplerCCC(py::module& m)
+{
+
+    using MTRationalResamplerCCC    = ::gr::lfast::MTRationalResamplerCCC;
+
+
+    py::class_<MTRationalResamplerCCC, gr::block,
+        std::shared_ptr<MTRationalResamplerCCC>>(m, "MTRationalResamplerCCC", D(MTRationalResamplerCCC))
+
+        .def(py::init(&MTRationalResamplerCCC::make),
+           py::arg("interpolation"),
+           py::arg("decimation"),
+           py::arg("taps"),
+           py::arg("nthreads"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTRationalResamplerCCC,make)
+        )
+        
+
+
+
+
+        
+        .def("set_taps",&MTRationalResamplerCCC::set_taps,       
+            py::arg("taps"),
+            D(MTRationalResamplerCCC,set_taps)
+        )
+
+
+        
+        .def("taps",&MTRationalResamplerCCC::taps,       
+            D(MTRationalResamplerCCC,taps)
+        )
+
+        .def("interpolation",&MTRationalResamplerCCC::interpolation,       
+            D(MTRationalResamplerCCC,interpolation)
+        )
+
+
+        .def("decimation",&MTRationalResamplerCCC::decimation,       
+            D(MTRationalResamplerCCC,decimation)
+        )
+
+
+        ;
+
+
+
+
+}
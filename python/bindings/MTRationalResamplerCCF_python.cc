@@ -0,0 +1,80 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTRationalResamplerCCF.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(85c74fba613ab6fb0e5fe66ff9eaead8)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTRationalResamplerCCF.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTRationalResamplerCCF_pydoc.h>
+
+void bind_MTRationalResamplerCCF(py::module& m)
+{
+
+    using MTRationalResamplerCCF    = ::gr::lfast::MTRationalResamplerCCF;
+
+
+    py::class_<MTRationalResamplerCCF, gr::block,
+        std::shared_ptr<MTRationalResamplerCCF>>(m, "MTRationalResamplerCCF", D(MTRationalResamplerCCF))
+
+        .def(py::init(&MTRationalResamplerCCF::make),
+           py::arg("interpolation"),
+           py::arg("decimation"),
+           py::arg("taps"),
+           py::arg("nthreads"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTRationalResamplerCCF,make)
+        )
+        
+
+
+
+
+        
+        .def("set_taps",&MTRationalResamplerCCF::set_taps,       
+            py::arg("taps"),
+            D(MTRationalResamplerCCF,set_taps)
+        )
+
+
+        
+        .def("taps",&MTRationalResamplerCCF::taps,       
+            D(MTRationalResamplerCCF,taps)
+        )
+
+        .def("interpolation",&MTRationalResamplerCCF::interpolation,       
+            D(MTRationalResamplerCCF,interpolation)
+        )
+
+
+        .def("decimation",&MTRationalResamplerCCF::decimation,       
+            D(MTRationalResamplerCCF,decimation)
+        )
+
+
+        ;
+
+
+
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(MTRationalResamplerFF.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(671a8f4d35848add72d61aa20274c9ff)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/MTRationalResamplerFF.h>
+// pydoc.h is automatically generated in the build directory
+#include <MTRationalResamplerFF_pydoc.h>
+
+void bind_MTRationalResamplerFF(py::module& m)
+{
+
+    using MTRationalResamplerFF    = ::gr::lfast::MTRationalResamplerFF;
+
+
+    py::class_<MTRationalResamplerFF, gr::block,
+        std::shared_ptr<MTRationalResamplerFF>>(m, "MTRationalResamplerFF", D(MTRationalResamplerFF))
+
+        .def(py::init(&MTRationalResamplerFF::make),
+           py::arg("interpolation"),
+           py::arg("decimation"),
+           py::arg("taps"),
+           py::arg("nthreads"),
+           py::arg("affinity") = 0,
+           py::arg("cores") = std::vector<int>(),
+           D(MTRationalResamplerFF,make)
+        )
+        
+
+
+
+
+        
+        .def("set_taps",&MTRationalResamplerFF::set_taps,       
+            py::arg("taps"),
+            D(MTRationalResamplerFF,set_taps)
+        )
+
+
+        
+        .def("taps",&MTRationalResamplerFF::taps,       
+            D(MTRationalResamplerFF,taps)
+        )
+
+        .def("interpolation",&MTRationalResamplerFF::interpolation,       
+            D(MTRationalResamplerFF,interpolation)
+        )
+
+
+        .def("decimation",&MTRationalResamplerFF::decimation,       
+            D(MTRationalResamplerFF,decimation)
+        )
+
+
+        ;
+
+
+
+
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(agc3_fast.h)                                               */
+/* BINDTOOL_HEADER_FILE_HASH(e3d30af5d9fe4accbdbe498e498410b8)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/agc3_fast.h>
+// pydoc.h is automatically generated in the build directory
+#include <agc3_fast_pydoc.h>
+
+void bind_agc3_fast(py::module& m)
+{
+
+    using agc3_fast    = ::gr::lfast::agc3_fast;
+
+
+    py::class_<agc3_fast, gr::sync_block, gr::block, gr::basic_block,
+        std::shared_ptr<agc3_fast>>(m, "agc3_fast", D(agc3_fast))
+
+        .def(py::init(&agc3_fast::make),
+           py::arg("attack_rate") = 1.0E-1,
+           py::arg("decay_rate") = 1.0E-2,
+           py::arg("reference") = 1.,
+           py::arg("gain") = 1.,
+           py::arg("iir_update_decim") = 1,
+           D(agc3_fast,make)
+        )
+        
+
+
+
+
+        
+        .def("attack_rate",&agc3_fast::attack_rate,       
+            D(agc3_fast,attack_rate)
+        )
+
+
+        
+        .def("decay_rate",&agc3_fast::decay_rate,       
+            D(agc3_fast,decay_rate)
+        )
+
+
+        
+        .def("reference",&agc3_fast::reference,       
+            D(agc3_fast,reference)
+        )
+
+
+        
+        .def("gain",&agc3_fast::gain,       
+            D(agc3_fast,gain)
+        )
+
+
+        
+        .def("max_gain",&agc3_fast::max_gain,       
+            D(agc3_fast,max_gain)
+        )
+
+
+        
+        .def("set_attack_rate",&agc3_fast::set_attack_rate,       
+            py::arg("rate"),
+            D(agc3_fast,set_attack_rate)
+        )
+
+
+        
+        .def("set_decay_rate",&agc3_fast::set_decay_rate,       
+            py::arg("rate"),
+            D(agc3_fast,set_decay_rate)
+        )
+
+
+        
+        .def("set_reference",&agc3_fast::set_reference,       
+            py::arg("reference"),
+            D(agc3_fast,set_reference)
+        )
+
+
+        
+        .def("set_gain",&agc3_fast::set_gain,       
+            py::arg("gain"),
+            D(agc3_fast,set_gain)
+        )
+
+
+        
+        .def("set_max_gain",&agc3_fast::set_max_gain,       
+            py::arg("max_gain"),
+            D(agc3_fast,set_max_gain)
+        )
+
+
+        
+        .def("iir_update_decim",&agc3_fast::iir_update_decim,       
+            D(agc3_fast,iir_update_decim)
+        )
+
+
+        
+        .def("reset",&agc3_fast::reset,       
+            D(agc3_fast,reset)
+        )
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(agc_fast_ff.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(f38e1f27ce92a3cac4580e2bc702df2f)                     */
+/* BINDTOOL_HEADER_FILE_HASH(c08bf626d72ad4b7609b7e8344063c1e)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -98,6 +98,32 @@ void bind_agc_fast_ff(py::module& m)
             D(agc_fast_ff,set_max_gain)
         )
 
+
+        
+        .def("set_block_size",&agc_fast_ff::set_block_size,       
+            py::arg("block_size"),
+            D(agc_fast_ff,set_block_size)
+        )
+
+
+        
+        .def("block_size",&agc_fast_ff::block_size,       
+            D(agc_fast_ff,block_size)
+        )
+
+
+        
+        .def("set_block_tolerance",&agc_fast_ff::set_block_tolerance,       
+            py::arg("tolerance"),
+            D(agc_fast_ff,set_block_tolerance)
+        )
+
+
+        
+        .def("block_tolerance",&agc_fast_ff::block_tolerance,       
+            D(agc_fast_ff,block_tolerance)
+        )
+
         ;
 
 
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(agc_fast_multi.h)                                  */
+/* BINDTOOL_HEADER_FILE_HASH(cd40fbc365d9fab140861ae1fe640347)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/agc_fast_multi.h>
+// pydoc.h is automatically generated in the build directory
+#include <agc_fast_multi_pydoc.h>
+
+void bind_agc_fast_multi(py::module& m)
+{
+
+    using agc_fast_multi    = ::gr::lfast::agc_fast_multi;
+
+
+    py::class_<agc_fast_multi, gr::sync_block, gr::block, gr::basic_block,
+        std::shared_ptr<agc_fast_multi>>(m, "agc_fast_multi", D(agc_fast_multi))
+
+        .def(py::init(&agc_fast_multi::make),
+           py::arg("nchannels"),
+           py::arg("rate") = 1.0E-4,
+           py::arg("reference") = 1.,
+           py::arg("gain") = 1.,
+           py::arg("max_gain") = 65536.,
+           py::arg("vector_input") = true,
+           D(agc_fast_multi,make)
+        )
+        
+
+
+
+
+        
+        .def("num_channels",&agc_fast_multi::num_channels,       
+            D(agc_fast_multi,num_channels)
+        )
+
+
+        
+        .def("rate",&agc_fast_multi::rate,       
+            D(agc_fast_multi,rate)
+        )
+
+
+        
+        .def("reference",&agc_fast_multi::reference,       
+            D(agc_fast_multi,reference)
+        )
+
+
+        
+        .def("max_gain",&agc_fast_multi::max_gain,       
+            D(agc_fast_multi,max_gain)
+        )
+
+
+        
+        .def("gain",&agc_fast_multi::gain,       
+            py::arg("channel"),
+            D(agc_fast_multi,gain)
+        )
+
+
+        
+        .def("gains",&agc_fast_multi::gains,       
+            D(agc_fast_multi,gains)
+        )
+
+
+        
+        .def("set_rate",&agc_fast_multi::set_rate,       
+            py::arg("rate"),
+            D(agc_fast_multi,set_rate)
+        )
+
+
+        
+        .def("set_reference",&agc_fast_multi::set_reference,       
+            py::arg("reference"),
+            D(agc_fast_multi,set_reference)
+        )
+
+
+        
+        .def("set_max_gain",&agc_fast_multi::set_max_gain,       
+            py::arg("max_gain"),
+            D(agc_fast_multi,set_max_gain)
+        )
+
+
+        
+        .def("set_gain",&agc_fast_multi::set_gain,       
+            py::arg("gain"),
+            D(agc_fast_multi,set_gain)
+        )
+
+
+        
+        .def("set_channel_gain",&agc_fast_multi::set_channel_gain,       
+            py::arg("channel"),
+            py::arg("gain"),
+            D(agc_fast_multi,set_channel_gain)
+        )
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(agc_fast.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(f55acbf11fe5c50f0d411d9b32439965)                     */
+/* BINDTOOL_HEADER_FILE_HASH(6d57e3ea7a75a57bc04a3e69f1741d88)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -98,6 +98,32 @@ void bind_agc_fast(py::module& m)
             D(agc_fast,set_max_gain)
         )
 
+
+        
+        .def("set_block_size",&agc_fast::set_block_size,       
+            py::arg("block_size"),
+            D(agc_fast,set_block_size)
+        )
+
+
+        
+        .def("block_size",&agc_fast::block_size,       
+            D(agc_fast,block_size)
+        )
+
+
+        
+        .def("set_block_tolerance",&agc_fast::set_block_tolerance,       
+            py::arg("tolerance"),
+            D(agc_fast,set_block_tolerance)
+        )
+
+
+        
+        .def("block_tolerance",&agc_fast::block_tolerance,       
+            D(agc_fast,block_tolerance)
+        )
+
         ;
 
 
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(costas2.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(67b06f96d3c792aea17cb1f00727ffbc)                     */
+/* BINDTOOL_HEADER_FILE_HASH(0967306458fa32b1f613360e5d074fda)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -52,6 +52,39 @@ void bind_costas2(py::module& m)
             D(costas2,error)
         )
 
+
+        .def("set_update_decimation",&costas2::set_update_decimation,       
+            py::arg("decim"),
+            D(costas2,set_update_decimation)
+        )
+
+
+        .def("update_decimation",&costas2::update_decimation,       
+            D(costas2,update_decimation)
+        )
+
+
+        .def("set_burst_mode",&costas2::set_burst_mode,       
+            py::arg("burst_mode"),
+            D(costas2,set_burst_mode)
+        )
+
+
+        .def("burst_mode",&costas2::burst_mode,       
+            D(costas2,burst_mode)
+        )
+
+
+        .def("set_burst_threads",&costas2::set_burst_threads,       
+            py::arg("nthreads"),
+            D(costas2,set_burst_threads)
+        )
+
+
+        .def("burst_threads",&costas2::burst_threads,       
+            D(costas2,burst_threads)
+        )
+
         ;
 
 
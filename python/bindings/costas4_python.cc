@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(costas4.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(07e40df1c47bcd5e7e7231e1aade786a)                     */
+/* BINDTOOL_HEADER_FILE_HASH(b932cb00e3f752fa1e8a57be5d7ca697)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -52,6 +52,39 @@ void bind_costas4(py::module& m)
             D(costas4,error)
         )
 
+
+        .def("set_update_decimation",&costas4::set_update_decimation,       
+            py::arg("decim"),
+            D(costas4,set_update_decimation)
+        )
+
+
+        .def("update_decimation",&costas4::update_decimation,       
+            D(costas4,update_decimation)
+        )
+
+
+        .def("set_burst_mode",&costas4::set_burst_mode,       
+            py::arg("burst_mode"),
+            D(costas4,set_burst_mode)
+        )
+
+
+        .def("burst_mode",&costas4::burst_mode,       
+            D(costas4,burst_mode)
+        )
+
+
+        .def("set_burst_threads",&costas4::set_burst_threads,       
+            py::arg("nthreads"),
+            D(costas4,set_burst_threads)
+        )
+
+
+        .def("burst_threads",&costas4::burst_threads,       
+            D(costas4,burst_threads)
+        )
+
         ;
 
 
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2022 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(costas_fast.h)                                    */
+/* BINDTOOL_HEADER_FILE_HASH(9a43af6264d0e416509b5d608167170e)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/costas_fast.h>
+// pydoc.h is automatically generated in the build directory
+#include <costas_fast_pydoc.h>
+
+void bind_costas_fast(py::module& m)
+{
+
+    using costas_fast    = ::gr::lfast::costas_fast;
+
+
+    py::class_<costas_fast, gr::sync_block, gr::block, gr::basic_block,
+        std::shared_ptr<costas_fast>>(m, "costas_fast", D(costas_fast))
+
+        .def(py::init(&costas_fast::make),
+           py::arg("loop_bw"),
+           py::arg("order"),
+           D(costas_fast,make)
+        )
+        
+
+
+
+
+        
+        .def("error",&costas_fast::error,       
+            D(costas_fast,error)
+        )
+
+
+        
+        .def("order",&costas_fast::order,       
+            D(costas_fast,order)
+        )
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr,lfast, __VA_ARGS__ )
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+ 
+ static const char *__doc_gr_lfast_MTRationalResamplerFF = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_MTRationalResamplerFF_MTRationalResamplerFF_0 = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_MTRationalResamplerFF_MTRationalResamplerFF_1 = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_MTRationalResamplerFF_make = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_MTRationalResamplerFF_set_taps = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_MTRationalResamplerFF_taps = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_MTRationalResamplerFF_interpolation = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_MTRationalResamplerFF_decimation = R"doc()doc";
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr,lfast, __VA_ARGS__ )
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+ 
+ static const char *__doc_gr_lfast_agc2_fast = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_agc2_fast_0 = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_agc2_fast_1 = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_make = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_attack_rate = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_decay_rate = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_reference = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_gain = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_max_gain = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_set_attack_rate = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_set_decay_rate = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_set_reference = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_set_gain = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc2_fast_set_max_gain = R"doc()doc";
+
+
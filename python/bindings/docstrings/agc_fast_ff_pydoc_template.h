@@ -51,4 +51,16 @@
 
  static const char *__doc_gr_lfast_agc_fast_ff_set_max_gain = R"doc()doc";
 
+
+ static const char *__doc_gr_lfast_agc_fast_ff_set_block_size = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_ff_block_size = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_ff_set_block_tolerance = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_ff_block_tolerance = R"doc()doc";
+
   
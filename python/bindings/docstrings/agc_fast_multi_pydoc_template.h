@@ -0,0 +1,63 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr,lfast, __VA_ARGS__ )
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+ 
+ static const char *__doc_gr_lfast_agc_fast_multi = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_agc_fast_multi_0 = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_agc_fast_multi_1 = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_make = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_num_channels = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_rate = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_reference = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_max_gain = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_gain = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_gains = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_set_rate = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_set_reference = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_set_max_gain = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_set_gain = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_multi_set_channel_gain = R"doc()doc";
+
+
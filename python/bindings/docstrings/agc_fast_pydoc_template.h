@@ -52,6 +52,18 @@
  static const char *__doc_gr_lfast_agc_fast_set_max_gain = R"doc()doc";
 
 
+ static const char *__doc_gr_lfast_agc_fast_set_block_size = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_block_size = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_set_block_tolerance = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_agc_fast_block_tolerance = R"doc()doc";
+
+
 
 
 
@@ -30,4 +30,22 @@
 
  static const char *__doc_gr_lfast_costas2_error = R"doc()doc";
 
+
+ static const char *__doc_gr_lfast_costas2_set_update_decimation = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas2_update_decimation = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas2_set_burst_mode = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas2_burst_mode = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas2_set_burst_threads = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas2_burst_threads = R"doc()doc";
+
   
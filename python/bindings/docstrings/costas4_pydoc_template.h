@@ -30,4 +30,22 @@
 
  static const char *__doc_gr_lfast_costas4_error = R"doc()doc";
 
+
+ static const char *__doc_gr_lfast_costas4_set_update_decimation = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas4_update_decimation = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas4_set_burst_mode = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas4_burst_mode = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas4_set_burst_threads = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas4_burst_threads = R"doc()doc";
+
   
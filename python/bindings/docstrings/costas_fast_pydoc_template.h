@@ -0,0 +1,36 @@
+/*
+ * Copyright 2022 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr,lfast, __VA_ARGS__ )
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+ 
+ static const char *__doc_gr_lfast_costas_fast = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas_fast_costas_fast_0 = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas_fast_costas_fast_1 = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas_fast_make = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas_fast_error = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_costas_fast_order = R"doc()doc";
+
+  
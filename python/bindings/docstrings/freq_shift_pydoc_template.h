@@ -0,0 +1,42 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "pydoc_macros.h"
+#define D(...) DOC(gr,lfast, __VA_ARGS__ )
+/*
+  This file contains placeholders for docstrings for the Python bindings.
+  Do not edit! These were automatically extracted during the binding process
+  and will be overwritten during the build process
+ */
+
+
+ 
+ static const char *__doc_gr_lfast_freq_shift = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_freq_shift_freq_shift_0 = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_freq_shift_freq_shift_1 = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_freq_shift_make = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_freq_shift_set_phase_inc = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_freq_shift_phase_inc = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_freq_shift_set_mode = R"doc()doc";
+
+
+ static const char *__doc_gr_lfast_freq_shift_mode = R"doc()doc";
+
+
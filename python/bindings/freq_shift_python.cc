@@ -0,0 +1,87 @@
+/*
+ * Copyright 2020 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(freq_shift.h)                                              */
+/* BINDTOOL_HEADER_FILE_HASH(a28fe98de79145951318f636aad804da)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <lfast/freq_shift.h>
+// pydoc.h is automatically generated in the build directory
+#include <freq_shift_pydoc.h>
+
+void bind_freq_shift(py::module& m)
+{
+
+    using freq_shift    = ::gr::lfast::freq_shift;
+
+
+    py::class_<freq_shift, gr::sync_block, gr::block, gr::basic_block,
+        std::shared_ptr<freq_shift>>(m, "freq_shift", D(freq_shift))
+
+        .def(py::init(&freq_shift::make),
+           py::arg("phase_inc") = 0.,
+           py::arg("mode") = 2,
+           D(freq_shift,make)
+        )
+        
+
+
+
+
+        
+        .def("set_phase_inc",&freq_shift::set_phase_inc,       
+            py::arg("phase_inc"),
+            D(freq_shift,set_phase_inc)
+        )
+
+
+        
+        .def("phase_inc",&freq_shift::phase_inc,       
+            D(freq_shift,phase_inc)
+        )
+
+
+        
+        .def("set_mode",&freq_shift::set_mode,       
+            py::arg("mode"),
+            D(freq_shift,set_mode)
+        )
+
+
+        
+        .def("mode",&freq_shift::mode,       
+            D(freq_shift,mode)
+        )
+
+        ;
+
+
+
+
+}
+
+
+
+
+
+
+
+
@@ -23,12 +23,29 @@ namespace py = pybind11;
 // BINDING_FUNCTION_PROTOTYPES(
     void bind_agc_fast_ff(py::module& m);
     void bind_agc_fast(py::module& m);
+    void bind_agc_fast_multi(py::module& m);
+    void bind_agc2_fast(py::module& m);
+    void bind_agc2_fast_ff(py::module& m);
+    void bind_agc3_fast(py::module& m);
+    void bind_freq_shift(py::module& m);
     void bind_CC2F2ByteVector(py::module& m);
     void bind_costas2(py::module& m);
     void bind_costas4(py::module& m);
+    void bind_costas_fast(py::module& m);
     void bind_MTFIRFilterCCC(py::module& m);
     void bind_MTFIRFilterCCF(py::module& m);
     void bind_MTFIRFilterFF(py::module& m);
+    void bind_MTFIRFilterSCF(py::module& m);
+    void bind_MTFIRFilterSCS(py::module& m);
+    void bind_MTHalfBandDecimatorCCF(py::module& m);
+    void bind_MTHalfBandDecimatorFF(py::module& m);
+    void bind_MTFilterChainCCF(py::module& m);
+    void bind_MTInterpFIRFilterCCC(py::module& m);
+    void bind_MTInterpFIRFilterCCF(py::module& m);
+    void bind_MTInterpFIRFilterFF(py::module& m);
+    void bind_MTRationalResamplerCCC(py::module& m);
+    void bind_MTRationalResamplerCCF(py::module& m);
+    void bind_MTRationalResamplerFF(py::module& m);
     void bind_nlog10volk(py::module& m);
     void bind_quad_demod_volk(py::module& m);
 // ) END BINDING_FUNCTION_PROTOTYPES
@@ -61,12 +78,29 @@ PYBIND11_MODULE(lfast_python, m)
     // BINDING_FUNCTION_CALLS(
     bind_agc_fast_ff(m);
     bind_agc_fast(m);
+    bind_agc_fast_multi(m);
+    bind_agc2_fast(m);
+    bind_agc2_fast_ff(m);
+    bind_agc3_fast(m);
+    bind_freq_shift(m);
     bind_CC2F2ByteVector(m);
     bind_costas2(m);
     bind_costas4(m);
+    bind_costas_fast(m);
     bind_MTFIRFilterCCC(m);
     bind_MTFIRFilterCCF(m);
     bind_MTFIRFilterFF(m);
+    bind_MTFIRFilterSCF(m);
+    bind_MTFIRFilterSCS(m);
+    bind_MTHalfBandDecimatorCCF(m);
+    bind_MTHalfBandDecimatorFF(m);
+    bind_MTFilterChainCCF(m);
+    bind_MTInterpFIRFilterCCC(m);
+    bind_MTInterpFIRFilterCCF(m);
+    bind_MTInterpFIRFilterFF(m);
+    bind_MTRationalResamplerCCC(m);
+    bind_MTRationalResamplerCCF(m);
+    bind_MTRationalResamplerFF(m);
     bind_nlog10volk(m);
     bind_quad_demod_volk(m);
     // ) END BINDING_FUNCTION_CALLS